@@ -1,18 +1,52 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 #include <vector>
+#include <algorithm>
+#include "../container-stats.h"
 using namespace std;
 
 /**
  * @class Matrix
  * @brief A templated 2D matrix class.
  * @tparam Object The type of elements stored in the matrix
+ *
+ * With CONTAINER_STATS defined, stats() reports the row arrays allocated, grown
+ * and copied (see container-stats.h).
  */
 template<typename Object>
-class Matrix
+class Matrix : public InstrumentedContainer
 {
 private:
     vector<vector<Object>> arr; ///< 2D vector storing matrix elements
+
+    /**
+     * @brief Resizes every row to cols, counting the rows that had to be reallocated
+     */
+    void resizeRows(int cols)
+    {
+        for (vector<Object>& row : arr)
+        {
+            size_t capacity = row.capacity(), size = row.size();
+            row.resize(cols);
+            if (row.capacity() != capacity)
+                countReallocation(capacity, row.capacity(), size, sizeof(Object));
+        }
+    }
+
+    /**
+     * @brief Counts the arrays and elements of a matrix just copied into arr
+     */
+    void countCopy()
+    {
+        if (arr.capacity() > 0)
+            countAllocation(arr.capacity() * sizeof(vector<Object>));
+        for (const vector<Object>& row : arr)
+        {
+            if (row.capacity() > 0)
+                countAllocation(row.capacity() * sizeof(Object));
+            countCopies(row.size());
+        }
+    }
     
 public:
     /**
@@ -22,8 +56,9 @@ public:
      */
     Matrix(int rows, int cols) : arr{rows}
     {
-        for (vector<Object>& row : arr)
-            row.resize(cols);
+        if (arr.capacity() > 0)
+            countAllocation(arr.capacity() * sizeof(vector<Object>));
+        resizeRows(cols);
     }
 
     /**
@@ -31,7 +66,9 @@ public:
      * @param matrix The 2D vector to copy
      */
     Matrix(vector<vector<Object>> matrix) : arr{matrix}
-    {}
+    {
+        countCopy();
+    }
 
     /**
      * @brief Constructs a matrix from an existing 2D vector (move).
@@ -46,6 +83,32 @@ public:
     Matrix() : arr{}
     {}
 
+    /**
+     * @brief Copy constructor; counts the copied rows and elements.
+     * @param rhs The matrix to copy
+     */
+    Matrix(const Matrix& rhs) : InstrumentedContainer{}, arr{rhs.arr}
+    {
+        countCopy();
+    }
+
+    Matrix(Matrix&& rhs) = default;
+
+    /**
+     * @brief Copy assignment through a temporary copy, whose counts this matrix takes over.
+     * @param rhs The matrix to copy
+     * @return Reference to this matrix
+     */
+    Matrix& operator=(const Matrix& rhs)
+    {
+        Matrix copy = rhs;
+        arr.swap(copy.arr);
+        absorbStats(copy);
+        return *this;
+    }
+
+    Matrix& operator=(Matrix&& rhs) = default;
+
     /**
      * @brief Accesses a row (const version).
      * @param row Row index
@@ -91,9 +154,11 @@ public:
      */
     void resize(int rows, int cols)
     {
+        size_t capacity = arr.capacity(), size = arr.size();
         arr.resize(rows);
-        for (vector<Object>& row : arr)
-            row.resize(cols);
+        if (arr.capacity() != capacity)
+            countReallocation(capacity, arr.capacity(), min<size_t>(size, rows), sizeof(vector<Object>));
+        resizeRows(cols);
     }
 };
 #endif
\ No newline at end of file
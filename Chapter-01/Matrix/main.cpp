@@ -1,5 +1,6 @@
 #include <iostream>
 #include "Matrix.h"
+#include "max-subrectangle.h"
 using namespace std;
 
 int main(void)
@@ -13,5 +14,11 @@ int main(void)
             cout << matrix[i][j] << ' ';
         cout << endl;
     }
+
+    vector<vector<int>> cells = {{0, -2, -7, 0}, {9, 2, -6, 2}, {-4, 1, -4, 1}, {-1, 8, 0, -2}};
+    Matrix<int> heatmap(cells);
+    SubRectangle best = maxSubRectangle(heatmap, 2);
+    cout << best.sum << " rows [" << best.top << ", " << best.bottom << ") columns ["
+         << best.left << ", " << best.right << ")" << endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,124 @@
+#ifndef MAX_SUBRECTANGLE_H
+#define MAX_SUBRECTANGLE_H
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include "Matrix.h"
+using namespace std;
+
+/**
+ * @brief A rectangle of cells [top, bottom) x [left, right) together with its sum
+ *
+ * As with maxSubarraySum, the empty rectangle with sum 0 is allowed, so a matrix
+ * with no positive entry yields sum 0 and top == bottom.
+ */
+struct SubRectangle
+{
+    long long sum;
+    int top;    ///< First row
+    int left;   ///< First column
+    int bottom; ///< One past the last row
+    int right;  ///< One past the last column
+};
+
+/**
+ * @brief Orders candidates by sum, then by position, so the answer does not depend on thread timing
+ */
+inline bool isBetterRectangle(const SubRectangle& a, const SubRectangle& b)
+{
+    if (a.sum != b.sum)
+        return a.sum > b.sum;
+    if (a.top != b.top)
+        return a.top < b.top;
+    if (a.left != b.left)
+        return a.left < b.left;
+    if (a.bottom != b.bottom)
+        return a.bottom < b.bottom;
+    return a.right < b.right;
+}
+
+/**
+ * @brief Finds the maximum-sum subrectangle of a matrix (2D Kadane)
+ *
+ * For every pair of rows (top, bottom) the columns are compressed into a running
+ * array of column sums, one row added per step, and a linear Kadane scan finds the
+ * best column range. The matrix is copied into a flat buffer and transposed first
+ * when it has more rows than columns, so the quadratic factor is the smaller side.
+ * Top rows are handed out to threads from a shared counter, and each thread keeps
+ * its own column-sum buffer.
+ *
+ * @param matrix Input matrix
+ * @param numThreads Number of threads (at least 1)
+ * @return The best rectangle and its coordinates in the original matrix
+ * @note Complexity: O(min(R, C)^2 * max(R, C)) time, O(R * C) extra space
+ */
+inline SubRectangle maxSubRectangle(const Matrix<int>& matrix, int numThreads = 1)
+{
+    const int rows = matrix.numRows(), cols = matrix.numCols();
+    const bool transposed = rows > cols;
+    const int height = transposed ? cols : rows;
+    const int width = transposed ? rows : cols;
+
+    vector<int> flat((size_t)height * width);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+            flat[transposed ? (size_t)j * width + i : (size_t)i * width + j] = matrix[i][j];
+
+    numThreads = max(1, min(numThreads, max(height, 1)));
+    vector<SubRectangle> best(numThreads, SubRectangle{0, 0, 0, 0, 0});
+    atomic<int> nextTop{0};
+
+    auto worker = [&](int t)
+    {
+        vector<long long> columnSums(width);
+        for (int top = nextTop++; top < height; top = nextTop++)
+        {
+            fill(columnSums.begin(), columnSums.end(), 0);
+            for (int bottom = top; bottom < height; bottom++)
+            {
+                // Plain element-wise add over contiguous arrays, left for the compiler to vectorize
+                const int* row = &flat[(size_t)bottom * width];
+                long long* sums = columnSums.data();
+                for (int j = 0; j < width; j++)
+                    sums[j] += row[j];
+
+                long long current = 0;
+                int currentStart = 0;
+                for (int j = 0; j < width; j++)
+                {
+                    if (current <= 0)
+                    {
+                        current = 0;
+                        currentStart = j;
+                    }
+                    current += sums[j];
+                    if (current > 0 && current >= best[t].sum)
+                    {
+                        SubRectangle candidate = {current, top, currentStart, bottom + 1, j + 1};
+                        if (isBetterRectangle(candidate, best[t]))
+                            best[t] = candidate;
+                    }
+                }
+            }
+        }
+    };
+
+    vector<thread> workers;
+    for (int t = 1; t < numThreads; t++)
+        workers.emplace_back(worker, t);
+    worker(0);
+    for (thread& w : workers)
+        w.join();
+
+    SubRectangle result = best[0];
+    for (int t = 1; t < numThreads; t++)
+        if (isBetterRectangle(best[t], result))
+            result = best[t];
+
+    if (transposed)
+        result = {result.sum, result.left, result.top, result.right, result.bottom};
+    return result;
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef BINARY_REPRESENTATION_H
+#define BINARY_REPRESENTATION_H
+using namespace std;
+
+/**
+ * @brief Counts the number of 1s in the binary representation of a number
+ * 
+ * This function recursively counts how many bits are set to 1 in the
+ * binary representation of the given integer. A negative int converts to
+ * its two's-complement bit pattern, so binaryOnes(-1) counts all 32 bits.
+ * For whole arrays, see popcount in bit-count/popcount.h.
+ * 
+ * @param number The integer to analyze
+ * @return int The count of 1s in the binary representation
+ * 
+ * @note Base case: when number is 0, returns 0
+ * @note Recursive case: halves the number and adds its lowest bit
+ * 
+ * @example binaryOnes(15) returns 4 (binary: 1111)
+ * @example binaryOnes(8) returns 1 (binary: 1000)
+ */
+inline int binaryOnes(unsigned int number)
+{
+    if (number == 0)
+        return 0;
+    else
+        return binaryOnes(number / 2) + number % 2;
+}
+
+#endif
@@ -0,0 +1,630 @@
+#ifndef BIT_VECTOR_H
+#define BIT_VECTOR_H
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include "popcount.h"
+using namespace std;
+
+/**
+ * @brief Exception thrown when select1 is asked for a one that does not exist
+ */
+class SelectOutOfRangeException {};
+
+/**
+ * @brief Exception thrown when rank or select is used after the bits changed without buildIndex
+ */
+class StaleIndexException {};
+
+/**
+ * @brief Exception thrown when a set operation combines bit vectors of different sizes
+ */
+class BitVectorSizeException {};
+
+/**
+ * @brief Exception thrown when a buffer does not hold a serialized bit vector
+ */
+class BitVectorFormatException {};
+
+/**
+ * @brief Bits covered by one packed rank entry (32 words)
+ */
+const uint64_t BITS_PER_SUPERBLOCK = 2048;
+
+/**
+ * @brief Bits per block inside a superblock; the entry stores the first three block counts
+ */
+const uint64_t BITS_PER_BLOCK = 512;
+
+/**
+ * @brief Every ONES_PER_SAMPLE-th one has its superblock recorded for select
+ */
+const uint64_t ONES_PER_SAMPLE = 8192;
+
+/**
+ * @brief Word-level bit operations without special instructions
+ */
+struct PortableBits
+{
+    static int count(uint64_t word)
+    {
+        return portablePopcount(word);
+    }
+
+    /**
+     * @brief Position of the k-th (0-based) set bit of a word that has more than k set bits
+     */
+    static int select(uint64_t word, int k)
+    {
+        int shift = 0;
+        for (int c = portablePopcount(word & 0xff); k >= c; c = portablePopcount((word >> shift) & 0xff))
+        {
+            k -= c;
+            shift += 8;
+        }
+        word >>= shift;
+        for (; k > 0; k--)
+            word &= word - 1;
+        return shift + __builtin_ctzll(word);
+    }
+};
+
+#ifdef POPCOUNT_X86
+/**
+ * @brief Word-level bit operations with POPCNT and BMI2 PDEP
+ */
+struct HardwareBits
+{
+    __attribute__((target("popcnt,bmi,bmi2"))) static int count(uint64_t word)
+    {
+        return __builtin_popcountll(word);
+    }
+
+    /**
+     * @brief Deposits a single bit at the k-th set position of word and finds it
+     */
+    __attribute__((target("popcnt,bmi,bmi2"))) static int select(uint64_t word, int k)
+    {
+        return __builtin_ctzll(_pdep_u64(uint64_t(1) << k, word));
+    }
+};
+#endif
+
+/**
+ * @brief Whether HardwareBits can run on this CPU, detected once
+ */
+inline bool hardwareBitsSupported()
+{
+#ifdef POPCOUNT_X86
+    static const bool supported = kernelSupported(PopcountKernel::Scalar) && __builtin_cpu_supports("bmi2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Size in bytes of the serialized header: magic, size in bits, number of ones and number of samples
+ */
+const size_t BIT_VECTOR_HEADER = 32;
+
+/**
+ * @class BitVectorView
+ * @brief Read-only bits with a rank/select index, over memory the view does not own.
+ *
+ * The index adds one 64-bit entry per 2048 bits (3.1%) and one 32-bit select sample
+ * per 8192 ones (at most 0.4%), plus one 64-bit count per 2^32 bits. An entry packs
+ * the ones before its superblock, relative to its 2^32-bit chunk, in its low 32 bits
+ * and the counts of the superblock's first three 512-bit blocks in three 10-bit fields,
+ * so rank1 reads one entry and at most eight words. select1 starts from the sampled
+ * superblock, binary-searches the superblocks up to the next sample and then walks
+ * the block counts and words.
+ */
+class BitVectorView
+{
+private:
+    const uint64_t* words;       ///< Bits; bit i is bit i % 64 of word i / 64
+    uint64_t numBits;
+    uint64_t numOnes;
+    const uint64_t* superblocks; ///< numBits / 2048 + 1 packed rank entries
+    const uint64_t* chunks;      ///< Ones before each 2^32-bit chunk, (numBits >> 32) + 1 entries
+    const uint32_t* samples;     ///< Superblock holding each ONES_PER_SAMPLE-th one
+    uint64_t sampleCount;
+
+    /**
+     * @brief Number of ones before a superblock
+     */
+    uint64_t onesBefore(uint64_t superblock) const
+    {
+        return chunks[superblock >> 21] + (superblocks[superblock] & 0xffffffff);
+    }
+
+    template <typename Bits>
+    __attribute__((always_inline)) inline uint64_t rankWith(uint64_t position) const
+    {
+        const uint64_t superblock = position / BITS_PER_SUPERBLOCK;
+        const uint64_t entry = superblocks[superblock];
+        uint64_t rank = onesBefore(superblock);
+        const uint64_t block = position / BITS_PER_BLOCK % 4;
+        for (uint64_t b = 0; b < block; b++)
+            rank += (entry >> (32 + 10 * b)) & 1023;
+
+        const uint64_t last = position / 64;
+        for (uint64_t w = superblock * 32 + block * 8; w < last; w++)
+            rank += Bits::count(words[w]);
+        if (position % 64 != 0)
+            rank += Bits::count(words[last] & ((uint64_t(1) << (position % 64)) - 1));
+        return rank;
+    }
+
+    template <typename Bits>
+    __attribute__((always_inline)) inline uint64_t selectWith(uint64_t k) const
+    {
+        // Last superblock with at most k ones before it, between this sample and the next
+        const uint64_t sample = k / ONES_PER_SAMPLE;
+        uint64_t low = samples[sample];
+        uint64_t high = sample + 1 < sampleCount ? samples[sample + 1] + 1 : numBits / BITS_PER_SUPERBLOCK + 1;
+        while (high - low > 1)
+        {
+            uint64_t middle = low + (high - low) / 2;
+            if (onesBefore(middle) <= k)
+                low = middle;
+            else
+                high = middle;
+        }
+
+        uint64_t remaining = k - onesBefore(low);
+        const uint64_t entry = superblocks[low];
+        uint64_t w = low * 32;
+        for (int b = 0; b < 3; b++)
+        {
+            uint64_t ones = (entry >> (32 + 10 * b)) & 1023;
+            if (remaining < ones)
+                break;
+            remaining -= ones;
+            w += 8;
+        }
+        for (;; w++)
+        {
+            uint64_t ones = Bits::count(words[w]);
+            if (remaining < ones)
+                break;
+            remaining -= ones;
+        }
+        return w * 64 + Bits::select(words[w], remaining);
+    }
+
+#ifdef POPCOUNT_X86
+    __attribute__((target("popcnt,bmi,bmi2"))) uint64_t rankHardware(uint64_t position) const
+    {
+        return rankWith<HardwareBits>(position);
+    }
+
+    __attribute__((target("popcnt,bmi,bmi2"))) uint64_t selectHardware(uint64_t k) const
+    {
+        return selectWith<HardwareBits>(k);
+    }
+#endif
+
+public:
+    /**
+     * @brief Views bits and an index laid out by BitVector
+     */
+    BitVectorView(const uint64_t* words, uint64_t numBits, uint64_t numOnes, const uint64_t* superblocks,
+                  const uint64_t* chunks, const uint32_t* samples, uint64_t sampleCount)
+        : words{words}, numBits{numBits}, numOnes{numOnes}, superblocks{superblocks}, chunks{chunks},
+          samples{samples}, sampleCount{sampleCount}
+    {}
+
+    /**
+     * @brief Views a buffer written by BitVector::serialize, e.g. a memory-mapped file
+     * @param buffer Start of the serialized bits, 8-byte aligned
+     * @param length Buffer size in bytes
+     * @throw BitVectorFormatException if the buffer is misaligned, too short or not a bit vector
+     */
+    BitVectorView(const char* buffer, size_t length)
+    {
+        if (reinterpret_cast<uintptr_t>(buffer) % 8 != 0 || length < BIT_VECTOR_HEADER
+            || memcmp(buffer, "BITVECT1", 8) != 0)
+            throw BitVectorFormatException();
+        const uint64_t* header = reinterpret_cast<const uint64_t*>(buffer);
+        numBits = header[1];
+        numOnes = header[2];
+        sampleCount = header[3];
+
+        const uint64_t wordCount = (numBits + 63) / 64;
+        const uint64_t superblockCount = numBits / BITS_PER_SUPERBLOCK + 1;
+        const uint64_t chunkCount = (numBits >> 32) + 1;
+        if (sampleCount != (numOnes + ONES_PER_SAMPLE - 1) / ONES_PER_SAMPLE
+            || length != BIT_VECTOR_HEADER + (wordCount + superblockCount + chunkCount + (sampleCount + 1) / 2) * 8)
+            throw BitVectorFormatException();
+        words = header + BIT_VECTOR_HEADER / 8;
+        superblocks = words + wordCount;
+        chunks = superblocks + superblockCount;
+        samples = reinterpret_cast<const uint32_t*>(chunks + chunkCount);
+    }
+
+    /**
+     * @brief Number of bits
+     */
+    uint64_t size() const
+    {
+        return numBits;
+    }
+
+    /**
+     * @brief Number of set bits
+     */
+    uint64_t count() const
+    {
+        return numOnes;
+    }
+
+    bool operator[](uint64_t i) const
+    {
+        return (words[i / 64] >> (i % 64)) & 1;
+    }
+
+    /**
+     * @brief Counts the set bits in [0, position)
+     * @param position Bit position, at most size()
+     * @note Complexity: O(1)
+     */
+    uint64_t rank1(uint64_t position) const
+    {
+#ifdef POPCOUNT_X86
+        if (hardwareBitsSupported())
+            return rankHardware(position);
+#endif
+        return rankWith<PortableBits>(position);
+    }
+
+    /**
+     * @brief Counts the clear bits in [0, position)
+     */
+    uint64_t rank0(uint64_t position) const
+    {
+        return position - rank1(position);
+    }
+
+    /**
+     * @brief Finds the position of the k-th set bit, counting from 0
+     *
+     * select1(rank1(i)) == i for every set bit i.
+     *
+     * @throw SelectOutOfRangeException if k >= count()
+     */
+    uint64_t select1(uint64_t k) const
+    {
+        if (k >= numOnes)
+            throw SelectOutOfRangeException();
+#ifdef POPCOUNT_X86
+        if (hardwareBitsSupported())
+            return selectHardware(k);
+#endif
+        return selectWith<PortableBits>(k);
+    }
+
+    /**
+     * @brief Calls visit(position) for every set bit in increasing order
+     *
+     * Each word is consumed by taking its lowest set bit with count-trailing-zeros and
+     * clearing it, so the cost follows the number of ones rather than bits.
+     */
+    template <typename Visitor>
+    void forEachSetBit(Visitor&& visit) const
+    {
+        const uint64_t wordCount = (numBits + 63) / 64;
+        for (uint64_t w = 0; w < wordCount; w++)
+            for (uint64_t word = words[w]; word != 0; word &= word - 1)
+                visit(w * 64 + __builtin_ctzll(word));
+    }
+
+    const uint64_t* data() const
+    {
+        return words;
+    }
+};
+
+/**
+ * @class BitVector
+ * @brief Dynamic bitset with word-parallel set operations and a rank/select index.
+ *
+ * Bits past size() in the last word are kept clear. Changing bits makes the index
+ * stale; call buildIndex() before using rank1, select1, view or serialize again.
+ */
+class BitVector
+{
+private:
+    vector<uint64_t> words;
+    uint64_t numBits;
+    uint64_t numOnes;
+    vector<uint64_t> superblocks;
+    vector<uint64_t> chunks;
+    vector<uint32_t> samples;
+    bool indexed;
+
+    /**
+     * @brief Clears the unused bits of the last word
+     */
+    void trim()
+    {
+        if (numBits % 64 != 0)
+            words.back() &= (uint64_t(1) << (numBits % 64)) - 1;
+        indexed = false;
+    }
+
+    void checkIndex() const
+    {
+        if (!indexed)
+            throw StaleIndexException();
+    }
+
+public:
+    /**
+     * @brief Constructs a bit vector
+     * @param size Number of bits
+     * @param value Initial value of every bit
+     */
+    explicit BitVector(uint64_t size = 0, bool value = false)
+        : words((size + 63) / 64, value ? ~uint64_t(0) : 0), numBits{size}, numOnes{0}, indexed{false}
+    {
+        trim();
+    }
+
+    uint64_t size() const
+    {
+        return numBits;
+    }
+
+    /**
+     * @brief Changes the number of bits; new bits get value
+     */
+    void resize(uint64_t size, bool value = false)
+    {
+        if (value && numBits % 64 != 0 && size > numBits)
+            words.back() |= ~uint64_t(0) << (numBits % 64);
+        words.resize((size + 63) / 64, value ? ~uint64_t(0) : 0);
+        numBits = size;
+        trim();
+    }
+
+    void push_back(bool value)
+    {
+        if (numBits % 64 == 0)
+            words.push_back(0);
+        numBits++;
+        set(numBits - 1, value);
+    }
+
+    bool operator[](uint64_t i) const
+    {
+        return (words[i / 64] >> (i % 64)) & 1;
+    }
+
+    void set(uint64_t i, bool value = true)
+    {
+        uint64_t mask = uint64_t(1) << (i % 64);
+        words[i / 64] = value ? words[i / 64] | mask : words[i / 64] & ~mask;
+        indexed = false;
+    }
+
+    void reset(uint64_t i)
+    {
+        set(i, false);
+    }
+
+    void flip(uint64_t i)
+    {
+        words[i / 64] ^= uint64_t(1) << (i % 64);
+        indexed = false;
+    }
+
+    /**
+     * @brief Flips every bit
+     */
+    void flip()
+    {
+        for (uint64_t& word : words)
+            word = ~word;
+        trim();
+    }
+
+    /**
+     * @throw BitVectorSizeException if the sizes differ
+     */
+    BitVector& operator&=(const BitVector& rhs)
+    {
+        if (rhs.numBits != numBits)
+            throw BitVectorSizeException();
+        for (size_t w = 0; w < words.size(); w++)
+            words[w] &= rhs.words[w];
+        indexed = false;
+        return *this;
+    }
+
+    BitVector& operator|=(const BitVector& rhs)
+    {
+        if (rhs.numBits != numBits)
+            throw BitVectorSizeException();
+        for (size_t w = 0; w < words.size(); w++)
+            words[w] |= rhs.words[w];
+        indexed = false;
+        return *this;
+    }
+
+    BitVector& operator^=(const BitVector& rhs)
+    {
+        if (rhs.numBits != numBits)
+            throw BitVectorSizeException();
+        for (size_t w = 0; w < words.size(); w++)
+            words[w] ^= rhs.words[w];
+        indexed = false;
+        return *this;
+    }
+
+    /**
+     * @brief Clears the bits that are set in rhs
+     */
+    BitVector& andNot(const BitVector& rhs)
+    {
+        if (rhs.numBits != numBits)
+            throw BitVectorSizeException();
+        for (size_t w = 0; w < words.size(); w++)
+            words[w] &= ~rhs.words[w];
+        indexed = false;
+        return *this;
+    }
+
+    friend BitVector operator&(BitVector lhs, const BitVector& rhs)
+    {
+        return lhs &= rhs;
+    }
+
+    friend BitVector operator|(BitVector lhs, const BitVector& rhs)
+    {
+        return lhs |= rhs;
+    }
+
+    friend BitVector operator^(BitVector lhs, const BitVector& rhs)
+    {
+        return lhs ^= rhs;
+    }
+
+    /**
+     * @brief Counts the set bits with the fastest popcount kernel; needs no index
+     */
+    uint64_t count() const
+    {
+        return indexed ? numOnes : popcount(words.data(), words.size());
+    }
+
+    /**
+     * @brief Counts the bits set in both vectors without building the intersection
+     * @throw BitVectorSizeException if the sizes differ
+     */
+    uint64_t countAnd(const BitVector& rhs) const
+    {
+        if (rhs.numBits != numBits)
+            throw BitVectorSizeException();
+        return popcountAnd(words.data(), rhs.words.data(), words.size());
+    }
+
+    /**
+     * @brief Builds the rank/select index for the current bits
+     * @note Complexity: O(size() / 64)
+     */
+    void buildIndex()
+    {
+        const uint64_t superblockCount = numBits / BITS_PER_SUPERBLOCK + 1;
+        superblocks.assign(superblockCount, 0);
+        chunks.assign((numBits >> 32) + 1, 0);
+        samples.clear();
+
+        uint64_t total = 0;
+        for (uint64_t sb = 0; sb < superblockCount; sb++)
+        {
+            if (sb % (uint64_t(1) << 21) == 0)
+                chunks[sb >> 21] = total;
+            uint64_t entry = total - chunks[sb >> 21];
+            uint64_t ones = 0;
+            for (uint64_t b = 0; b < 4; b++)
+            {
+                uint64_t first = min<uint64_t>(words.size(), sb * 32 + b * 8);
+                uint64_t last = min<uint64_t>(words.size(), first + 8);
+                uint64_t blockOnes = popcount(words.data() + first, last - first);
+                if (b < 3)
+                    entry |= blockOnes << (32 + 10 * b);
+                ones += blockOnes;
+            }
+            while (samples.size() * ONES_PER_SAMPLE < total + ones)
+                samples.push_back(sb);
+            superblocks[sb] = entry;
+            total += ones;
+        }
+        numOnes = total;
+        indexed = true;
+    }
+
+    /**
+     * @brief Bytes used by the rank/select index
+     */
+    size_t indexBytes() const
+    {
+        return superblocks.size() * sizeof(uint64_t) + chunks.size() * sizeof(uint64_t) + samples.size() * sizeof(uint32_t);
+    }
+
+    /**
+     * @brief Read-only view for queries
+     * @throw StaleIndexException if the bits changed since buildIndex
+     */
+    BitVectorView view() const
+    {
+        checkIndex();
+        return BitVectorView(words.data(), numBits, numOnes, superblocks.data(), chunks.data(), samples.data(),
+                             samples.size());
+    }
+
+    /**
+     * @throw StaleIndexException if the bits changed since buildIndex
+     */
+    uint64_t rank1(uint64_t position) const
+    {
+        return view().rank1(position);
+    }
+
+    uint64_t rank0(uint64_t position) const
+    {
+        return view().rank0(position);
+    }
+
+    /**
+     * @throw StaleIndexException if the bits changed since buildIndex
+     * @throw SelectOutOfRangeException if k >= count()
+     */
+    uint64_t select1(uint64_t k) const
+    {
+        return view().select1(k);
+    }
+
+    /**
+     * @brief Calls visit(position) for every set bit in increasing order; needs no index
+     */
+    template <typename Visitor>
+    void forEachSetBit(Visitor&& visit) const
+    {
+        BitVectorView(words.data(), numBits, 0, nullptr, nullptr, nullptr, 0).forEachSetBit(visit);
+    }
+
+    /**
+     * @brief Writes the bits and the index into one buffer that BitVectorView can use in place
+     *
+     * Layout, in 64-bit host-order words: "BITVECT1", size in bits, number of ones,
+     * number of samples, then the bit words, the superblock entries, the chunk counts
+     * and the 32-bit samples padded to a whole word.
+     *
+     * @throw StaleIndexException if the bits changed since buildIndex
+     */
+    vector<char> serialize() const
+    {
+        checkIndex();
+        const uint64_t header[4] = {0, numBits, numOnes, samples.size()};
+        vector<char> buffer(BIT_VECTOR_HEADER + (words.size() + superblocks.size() + chunks.size() + (samples.size() + 1) / 2) * 8);
+        char* out = buffer.data();
+        memcpy(out, header, sizeof(header));
+        memcpy(out, "BITVECT1", 8);
+        out += BIT_VECTOR_HEADER;
+        for (const vector<uint64_t>* part : {&words, &superblocks, &chunks})
+        {
+            if (!part->empty())
+                memcpy(out, part->data(), part->size() * sizeof(uint64_t));
+            out += part->size() * sizeof(uint64_t);
+        }
+        if (!samples.empty())
+            memcpy(out, samples.data(), samples.size() * sizeof(uint32_t));
+        return buffer;
+    }
+};
+
+#endif
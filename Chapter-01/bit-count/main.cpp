@@ -0,0 +1,65 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include "popcount.h"
+#include "bit-vector.h"
+using namespace std;
+
+/**
+ * @brief Counts the bits of a random bitmap with every kernel the CPU supports
+ *
+ * Usage: ./main [megabytes]
+ * Defaults to a 256 MB bitmap. Prints each kernel's count and throughput, then
+ * the AND/OR counts and the rank of the middle bit with the fastest kernel. The
+ * bitmap is then indexed as a BitVector, round-tripped through its serialized
+ * form, and queried for rank and select.
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    size_t words = (argc > 1 ? stoull(argv[1]) : 256) * (1 << 20) / sizeof(uint64_t);
+    vector<uint64_t> a(words), b(words);
+    mt19937_64 generator(11);
+    for (size_t i = 0; i < words; i++)
+    {
+        a[i] = generator();
+        b[i] = generator();
+    }
+
+    for (PopcountKernel kernel : {PopcountKernel::Portable, PopcountKernel::Scalar, PopcountKernel::AVX2, PopcountKernel::AVX512})
+    {
+        if (!kernelSupported(kernel))
+        {
+            printf("%-9s unsupported\n", kernelName(kernel).c_str());
+            continue;
+        }
+        auto start = chrono::high_resolution_clock::now();
+        uint64_t count = popcount(a.data(), words, kernel);
+        auto stop = chrono::high_resolution_clock::now();
+        double seconds = chrono::duration<double>(stop - start).count();
+        printf("%-9s %llu bits, %.2f GB/s\n", kernelName(kernel).c_str(), (unsigned long long)count,
+               words * sizeof(uint64_t) / seconds / 1e9);
+    }
+
+    cout << "best kernel: " << kernelName(bestPopcountKernel()) << endl;
+    cout << "a AND b: " << popcountAnd(a.data(), b.data(), words) << endl;
+    cout << "a OR b: " << popcountOr(a.data(), b.data(), words) << endl;
+    cout << "rank of bit " << words * 32 << ": " << bitmapRank(a.data(), words * 32) << endl;
+
+    BitVector bits(words * 64);
+    for (size_t i = 0; i < words; i++)
+        for (uint64_t word = a[i]; word != 0; word &= word - 1)
+            bits.set(i * 64 + __builtin_ctzll(word));
+    bits.buildIndex();
+    printf("index: %zu bytes, %.2f%% of the bits\n", bits.indexBytes(), 100.0 * bits.indexBytes() / (words * 8));
+
+    vector<char> serialized = bits.serialize();
+    BitVectorView view(serialized.data(), serialized.size());
+    uint64_t middle = view.count() / 2;
+    cout << "one #" << middle << " is bit " << view.select1(middle) << ", rank there: " << view.rank1(view.select1(middle)) << endl;
+    return 0;
+}
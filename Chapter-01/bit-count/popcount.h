@@ -0,0 +1,358 @@
+#ifndef POPCOUNT_H
+#define POPCOUNT_H
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define POPCOUNT_X86 1
+#include <immintrin.h>
+#endif
+using namespace std;
+
+/**
+ * @brief Exception thrown when a kernel is requested that this CPU cannot run
+ */
+class UnsupportedKernelException {};
+
+/**
+ * @brief Bit-counting kernels, from slowest to fastest
+ */
+enum class PopcountKernel
+{
+    Portable, ///< Bit-twiddling on 64-bit words, any CPU
+    Scalar,   ///< Hardware POPCNT on 64-bit words
+    AVX2,     ///< Harley–Seal carry-save adders over 256-bit vectors with a nibble lookup table
+    AVX512    ///< AVX-512 VPOPCNTQ over 512-bit vectors
+};
+
+/**
+ * @brief Display name of a kernel
+ */
+inline string kernelName(PopcountKernel kernel)
+{
+    switch (kernel)
+    {
+    case PopcountKernel::Portable: return "portable";
+    case PopcountKernel::Scalar: return "popcnt";
+    case PopcountKernel::AVX2: return "avx2";
+    default: return "avx512";
+    }
+}
+
+/**
+ * @brief Checks whether the running CPU (and OS) supports a kernel
+ */
+inline bool kernelSupported(PopcountKernel kernel)
+{
+#ifdef POPCOUNT_X86
+    switch (kernel)
+    {
+    case PopcountKernel::Portable: return true;
+    case PopcountKernel::Scalar: return __builtin_cpu_supports("popcnt");
+    case PopcountKernel::AVX2: return __builtin_cpu_supports("avx2");
+    default: return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+    }
+#else
+    return kernel == PopcountKernel::Portable;
+#endif
+}
+
+/**
+ * @brief Fastest kernel this CPU supports, detected once
+ */
+inline PopcountKernel bestPopcountKernel()
+{
+    static const PopcountKernel best = []()
+    {
+        for (PopcountKernel kernel : {PopcountKernel::AVX512, PopcountKernel::AVX2, PopcountKernel::Scalar})
+            if (kernelSupported(kernel))
+                return kernel;
+        return PopcountKernel::Portable;
+    }();
+    return best;
+}
+
+/**
+ * @brief Counts the set bits of one word without the POPCNT instruction
+ */
+inline int portablePopcount(uint64_t x)
+{
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return (x * 0x0101010101010101ull) >> 56;
+}
+
+/**
+ * @brief Word sources for the kernels: one bitmap, or two bitmaps combined word by word
+ *
+ * Each source gives word i, and on x86 the 256-bit block starting at word i and the
+ * 512-bit block (optionally masked) starting at word i, so the kernels are written once.
+ */
+struct BitmapWords
+{
+    const uint64_t* a;
+
+    uint64_t word(size_t i) const
+    {
+        return a[i];
+    }
+
+#ifdef POPCOUNT_X86
+    __attribute__((target("avx2"))) __m256i block256(size_t i) const
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    }
+
+    __attribute__((target("avx512f"))) __m512i block512(size_t i, __mmask8 mask = 0xff) const
+    {
+        return _mm512_maskz_loadu_epi64(mask, a + i);
+    }
+#endif
+};
+
+struct AndWords
+{
+    const uint64_t* a;
+    const uint64_t* b;
+
+    uint64_t word(size_t i) const
+    {
+        return a[i] & b[i];
+    }
+
+#ifdef POPCOUNT_X86
+    __attribute__((target("avx2"))) __m256i block256(size_t i) const
+    {
+        return _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+    }
+
+    __attribute__((target("avx512f"))) __m512i block512(size_t i, __mmask8 mask = 0xff) const
+    {
+        return _mm512_and_si512(_mm512_maskz_loadu_epi64(mask, a + i), _mm512_maskz_loadu_epi64(mask, b + i));
+    }
+#endif
+};
+
+struct OrWords
+{
+    const uint64_t* a;
+    const uint64_t* b;
+
+    uint64_t word(size_t i) const
+    {
+        return a[i] | b[i];
+    }
+
+#ifdef POPCOUNT_X86
+    __attribute__((target("avx2"))) __m256i block256(size_t i) const
+    {
+        return _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                               _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+    }
+
+    __attribute__((target("avx512f"))) __m512i block512(size_t i, __mmask8 mask = 0xff) const
+    {
+        return _mm512_or_si512(_mm512_maskz_loadu_epi64(mask, a + i), _mm512_maskz_loadu_epi64(mask, b + i));
+    }
+#endif
+};
+
+/**
+ * @brief Portable kernel
+ */
+template <typename Words>
+uint64_t popcountPortable(const Words& words, size_t count)
+{
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; i++)
+        total += portablePopcount(words.word(i));
+    return total;
+}
+
+#ifdef POPCOUNT_X86
+/**
+ * @brief Hardware POPCNT kernel, with four accumulators to hide the instruction latency
+ */
+template <typename Words>
+__attribute__((target("popcnt"))) uint64_t popcountScalar(const Words& words, size_t count)
+{
+    uint64_t t0 = 0, t1 = 0, t2 = 0, t3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        t0 += __builtin_popcountll(words.word(i));
+        t1 += __builtin_popcountll(words.word(i + 1));
+        t2 += __builtin_popcountll(words.word(i + 2));
+        t3 += __builtin_popcountll(words.word(i + 3));
+    }
+    for (; i < count; i++)
+        t0 += __builtin_popcountll(words.word(i));
+    return t0 + t1 + t2 + t3;
+}
+
+/**
+ * @brief Bit counts of the four 64-bit lanes of v, by looking up each nibble
+ */
+__attribute__((target("avx2"))) inline __m256i popcount256(__m256i v)
+{
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(v, low)),
+                                     _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+    return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+}
+
+/**
+ * @brief Carry-save adder: adds three bit vectors into a sum and a carry bit vector
+ */
+__attribute__((target("avx2"))) inline void carrySave(__m256i& carry, __m256i& sum, __m256i a, __m256i b, __m256i c)
+{
+    __m256i u = _mm256_xor_si256(a, b);
+    carry = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    sum = _mm256_xor_si256(u, c);
+}
+
+/**
+ * @brief AVX2 Harley–Seal kernel
+ *
+ * A tree of carry-save adders folds 16 vectors into the ones, twos, fours and
+ * eights bit vectors plus one sixteens vector, so only one vector in 16 goes
+ * through the nibble lookup.
+ */
+template <typename Words>
+__attribute__((target("avx2,popcnt"))) uint64_t popcountAVX2(const Words& words, size_t count)
+{
+    __m256i total = _mm256_setzero_si256();
+    __m256i ones = _mm256_setzero_si256(), twos = ones, fours = ones, eights = ones, sixteens;
+    __m256i twosA, twosB, foursA, foursB, eightsA, eightsB;
+    size_t i = 0;
+    for (; i + 64 <= count; i += 64)
+    {
+        carrySave(twosA, ones, ones, words.block256(i), words.block256(i + 4));
+        carrySave(twosB, ones, ones, words.block256(i + 8), words.block256(i + 12));
+        carrySave(foursA, twos, twos, twosA, twosB);
+        carrySave(twosA, ones, ones, words.block256(i + 16), words.block256(i + 20));
+        carrySave(twosB, ones, ones, words.block256(i + 24), words.block256(i + 28));
+        carrySave(foursB, twos, twos, twosA, twosB);
+        carrySave(eightsA, fours, fours, foursA, foursB);
+        carrySave(twosA, ones, ones, words.block256(i + 32), words.block256(i + 36));
+        carrySave(twosB, ones, ones, words.block256(i + 40), words.block256(i + 44));
+        carrySave(foursA, twos, twos, twosA, twosB);
+        carrySave(twosA, ones, ones, words.block256(i + 48), words.block256(i + 52));
+        carrySave(twosB, ones, ones, words.block256(i + 56), words.block256(i + 60));
+        carrySave(foursB, twos, twos, twosA, twosB);
+        carrySave(eightsB, fours, fours, foursA, foursB);
+        carrySave(sixteens, eights, eights, eightsA, eightsB);
+        total = _mm256_add_epi64(total, popcount256(sixteens));
+    }
+    total = _mm256_slli_epi64(total, 4);
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(eights), 3));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(fours), 2));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(twos), 1));
+    total = _mm256_add_epi64(total, popcount256(ones));
+    for (; i + 4 <= count; i += 4)
+        total = _mm256_add_epi64(total, popcount256(words.block256(i)));
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), total);
+    uint64_t result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < count; i++)
+        result += __builtin_popcountll(words.word(i));
+    return result;
+}
+
+/**
+ * @brief AVX-512 VPOPCNTQ kernel; the last partial block is read with a masked load
+ */
+template <typename Words>
+__attribute__((target("avx512f,avx512vpopcntdq"))) uint64_t popcountAVX512(const Words& words, size_t count)
+{
+    __m512i total0 = _mm512_setzero_si512(), total1 = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        total0 = _mm512_add_epi64(total0, _mm512_popcnt_epi64(words.block512(i)));
+        total1 = _mm512_add_epi64(total1, _mm512_popcnt_epi64(words.block512(i + 8)));
+    }
+    for (; i < count; i += 8)
+    {
+        __mmask8 mask = count - i >= 8 ? 0xff : (__mmask8)((1u << (count - i)) - 1);
+        total0 = _mm512_add_epi64(total0, _mm512_popcnt_epi64(words.block512(i, mask)));
+    }
+    uint64_t lanes[8];
+    _mm512_storeu_si512(lanes, _mm512_add_epi64(total0, total1));
+    uint64_t result = 0;
+    for (uint64_t lane : lanes)
+        result += lane;
+    return result;
+}
+#endif
+
+/**
+ * @brief Runs a kernel over a word source
+ * @throw UnsupportedKernelException if the CPU cannot run the kernel
+ */
+template <typename Words>
+uint64_t popcountWords(const Words& words, size_t count, PopcountKernel kernel)
+{
+    if (!kernelSupported(kernel))
+        throw UnsupportedKernelException();
+#ifdef POPCOUNT_X86
+    switch (kernel)
+    {
+    case PopcountKernel::Scalar: return popcountScalar(words, count);
+    case PopcountKernel::AVX2: return popcountAVX2(words, count);
+    case PopcountKernel::AVX512: return popcountAVX512(words, count);
+    default: break;
+    }
+#endif
+    return popcountPortable(words, count);
+}
+
+/**
+ * @brief Counts the set bits of a bitmap
+ * @param bitmap Bitmap words
+ * @param count Number of 64-bit words
+ * @param kernel Kernel to use, by default the fastest one the CPU supports
+ * @throw UnsupportedKernelException if the CPU cannot run the kernel
+ */
+inline uint64_t popcount(const uint64_t* bitmap, size_t count, PopcountKernel kernel = bestPopcountKernel())
+{
+    return popcountWords(BitmapWords{bitmap}, count, kernel);
+}
+
+/**
+ * @brief Counts the bits set in both of two equally long bitmaps, without materializing a AND b
+ */
+inline uint64_t popcountAnd(const uint64_t* a, const uint64_t* b, size_t count, PopcountKernel kernel = bestPopcountKernel())
+{
+    return popcountWords(AndWords{a, b}, count, kernel);
+}
+
+/**
+ * @brief Counts the bits set in either of two equally long bitmaps, without materializing a OR b
+ */
+inline uint64_t popcountOr(const uint64_t* a, const uint64_t* b, size_t count, PopcountKernel kernel = bestPopcountKernel())
+{
+    return popcountWords(OrWords{a, b}, count, kernel);
+}
+
+/**
+ * @brief Counts the set bits before a position of a bitmap
+ * @param bitmap Bitmap words; bit i is bit i % 64 of word i / 64
+ * @param position Bit position, at most the bitmap's size in bits
+ * @return Number of set bits in [0, position)
+ * @note Complexity: O(position / 64)
+ */
+inline uint64_t bitmapRank(const uint64_t* bitmap, uint64_t position, PopcountKernel kernel = bestPopcountKernel())
+{
+    uint64_t rank = popcount(bitmap, position / 64, kernel);
+    if (position % 64 != 0)
+        rank += portablePopcount(bitmap[position / 64] & ((uint64_t(1) << (position % 64)) - 1));
+    return rank;
+}
+
+#endif
@@ -1,6 +1,10 @@
 #ifndef COLLECTION_H
 #define COLLECTION_H
+#include "../container-stats.h"
 
+// Shared with the other collection headers so both can be included together
+#ifndef COLLECTION_EXCEPTIONS
+#define COLLECTION_EXCEPTIONS
 /**
  * @brief Exception thrown when attempting to insert into a full collection
  */
@@ -15,13 +19,17 @@ class EmptyCollectionException {};
  * @brief Exception thrown when object is not found in the collection
  */
 class ObjectNotFoundException {};
+#endif
 
 /**
  * @brief A dynamic array-based collection template class
  * @tparam Object Type of objects stored in the collection
+ *
+ * With CONTAINER_STATS defined, stats() reports the insertions copied in and the
+ * elements shifted by remove() (see container-stats.h).
  */
 template <typename Object>
-class Collection
+class Collection : public InstrumentedContainer
 {
 private:
     int lastPointer;  ///< Index of last element (-1 if empty)
@@ -38,6 +46,7 @@ public:
         maxSize = size;
         arr = new Object[size];
         lastPointer = -1;
+        countAllocation(size * sizeof(Object));
     }
 
     /// Copy constructor deleted - no copying allowed
@@ -67,6 +76,7 @@ public:
         {
             lastPointer++;
             arr[lastPointer] = obj;
+            countCopies(1);
         }
     }
 
@@ -116,6 +126,7 @@ public:
                 {
                     for (int j = i + 1; j <= lastPointer; j++)
                         arr[j - 1] = arr[j];
+                    countShifts(lastPointer - i);
                     lastPointer--;
                     return;
                 }
@@ -141,6 +152,42 @@ public:
         return false;
     }
 
+    /**
+     * @brief Gets a pointer to the first element
+     * @return Pointer to the start of the stored elements
+     */
+    Object* begin()
+    {
+        return arr;
+    }
+
+    /**
+     * @brief Gets a pointer to the first element (const version)
+     * @return Const pointer to the start of the stored elements
+     */
+    const Object* begin() const
+    {
+        return arr;
+    }
+
+    /**
+     * @brief Gets a pointer past the last element
+     * @return Pointer one past the last stored element
+     */
+    Object* end()
+    {
+        return arr + lastPointer + 1;
+    }
+
+    /**
+     * @brief Gets a pointer past the last element (const version)
+     * @return Const pointer one past the last stored element
+     */
+    const Object* end() const
+    {
+        return arr + lastPointer + 1;
+    }
+
     /**
      * @brief Destructor to free allocated memory
      */
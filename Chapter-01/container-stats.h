@@ -0,0 +1,228 @@
+#ifndef CONTAINER_STATS_H
+#define CONTAINER_STATS_H
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+using namespace std;
+
+/**
+ * @brief Counts kept by the instrumented containers (Vector, Matrix, Collection, OrderedCollection)
+ *
+ * Instrumentation is compiled in only when CONTAINER_STATS is defined before the
+ * container headers are included (e.g. -DCONTAINER_STATS). Otherwise every
+ * counting call is an empty inline function and the containers keep their size.
+ */
+struct ContainerStats
+{
+    uint64_t allocations = 0;    ///< Element arrays allocated
+    uint64_t bytesAllocated = 0; ///< Bytes in those arrays
+    uint64_t copies = 0;         ///< Elements copied in or from another container
+    uint64_t moves = 0;          ///< Elements moved, mostly when an array is reallocated
+    uint64_t shifts = 0;         ///< Elements moved one slot to open or close a gap
+    uint64_t growths = 0;        ///< Reallocations to a larger capacity
+
+    ContainerStats& operator+=(const ContainerStats& rhs)
+    {
+        allocations += rhs.allocations;
+        bytesAllocated += rhs.bytesAllocated;
+        copies += rhs.copies;
+        moves += rhs.moves;
+        shifts += rhs.shifts;
+        growths += rhs.growths;
+        return *this;
+    }
+
+    ContainerStats& operator-=(const ContainerStats& rhs)
+    {
+        allocations -= rhs.allocations;
+        bytesAllocated -= rhs.bytesAllocated;
+        copies -= rhs.copies;
+        moves -= rhs.moves;
+        shifts -= rhs.shifts;
+        growths -= rhs.growths;
+        return *this;
+    }
+};
+
+#ifdef CONTAINER_STATS
+constexpr bool CONTAINER_STATS_ENABLED = true;
+
+/**
+ * @brief Process-wide totals of every instrumented container, safe to update from any thread
+ */
+struct GlobalContainerCounters
+{
+    atomic<uint64_t> allocations{0};
+    atomic<uint64_t> bytesAllocated{0};
+    atomic<uint64_t> copies{0};
+    atomic<uint64_t> moves{0};
+    atomic<uint64_t> shifts{0};
+    atomic<uint64_t> growths{0};
+};
+
+inline GlobalContainerCounters& globalContainerCounters()
+{
+    static GlobalContainerCounters counters;
+    return counters;
+}
+
+/**
+ * @brief Snapshot of the process-wide totals
+ */
+inline ContainerStats globalContainerStats()
+{
+    GlobalContainerCounters& counters = globalContainerCounters();
+    ContainerStats stats;
+    stats.allocations = counters.allocations.load(memory_order_relaxed);
+    stats.bytesAllocated = counters.bytesAllocated.load(memory_order_relaxed);
+    stats.copies = counters.copies.load(memory_order_relaxed);
+    stats.moves = counters.moves.load(memory_order_relaxed);
+    stats.shifts = counters.shifts.load(memory_order_relaxed);
+    stats.growths = counters.growths.load(memory_order_relaxed);
+    return stats;
+}
+
+inline void resetGlobalContainerStats()
+{
+    GlobalContainerCounters& counters = globalContainerCounters();
+    counters.allocations = 0;
+    counters.bytesAllocated = 0;
+    counters.copies = 0;
+    counters.moves = 0;
+    counters.shifts = 0;
+    counters.growths = 0;
+}
+
+/**
+ * @class InstrumentedContainer
+ * @brief Base class holding one container's counts and forwarding them to the global totals
+ *
+ * A copied or moved-to container starts with its own zero counts; the counts
+ * describe the work done by that instance, not the history of its contents.
+ */
+class InstrumentedContainer
+{
+private:
+    ContainerStats counts;
+
+public:
+    InstrumentedContainer() = default;
+
+    InstrumentedContainer(const InstrumentedContainer&)
+    {}
+
+    InstrumentedContainer& operator=(const InstrumentedContainer&)
+    {
+        return *this;
+    }
+
+    /**
+     * @brief Counts of this container since construction or the last resetStats()
+     */
+    ContainerStats stats() const
+    {
+        return counts;
+    }
+
+    void resetStats()
+    {
+        counts = ContainerStats();
+    }
+
+protected:
+    void countAllocation(size_t bytes)
+    {
+        counts.allocations++;
+        counts.bytesAllocated += bytes;
+        globalContainerCounters().allocations.fetch_add(1, memory_order_relaxed);
+        globalContainerCounters().bytesAllocated.fetch_add(bytes, memory_order_relaxed);
+    }
+
+    void countCopies(size_t count)
+    {
+        counts.copies += count;
+        globalContainerCounters().copies.fetch_add(count, memory_order_relaxed);
+    }
+
+    void countMoves(size_t count)
+    {
+        counts.moves += count;
+        globalContainerCounters().moves.fetch_add(count, memory_order_relaxed);
+    }
+
+    void countShifts(size_t count)
+    {
+        counts.shifts += count;
+        globalContainerCounters().shifts.fetch_add(count, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Counts a new array of newCapacity elements replacing one of oldCapacity, moving moved elements
+     */
+    void countReallocation(size_t oldCapacity, size_t newCapacity, size_t moved, size_t elementSize)
+    {
+        countAllocation(newCapacity * elementSize);
+        countMoves(moved);
+        if (oldCapacity > 0 && newCapacity > oldCapacity)
+        {
+            counts.growths++;
+            globalContainerCounters().growths.fetch_add(1, memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Adds counts recorded by a temporary, e.g. the copy in copy-and-swap, to this container only
+     */
+    void absorbStats(const InstrumentedContainer& other)
+    {
+        counts += other.counts;
+    }
+};
+#else
+constexpr bool CONTAINER_STATS_ENABLED = false;
+
+inline ContainerStats globalContainerStats()
+{
+    return ContainerStats();
+}
+
+inline void resetGlobalContainerStats()
+{}
+
+/**
+ * @class InstrumentedContainer
+ * @brief Empty stand-in when CONTAINER_STATS is not defined; every count is a no-op
+ */
+class InstrumentedContainer
+{
+public:
+    ContainerStats stats() const
+    {
+        return ContainerStats();
+    }
+
+    void resetStats()
+    {}
+
+protected:
+    void countAllocation(size_t)
+    {}
+
+    void countCopies(size_t)
+    {}
+
+    void countMoves(size_t)
+    {}
+
+    void countShifts(size_t)
+    {}
+
+    void countReallocation(size_t, size_t, size_t, size_t)
+    {}
+
+    void absorbStats(const InstrumentedContainer&)
+    {}
+};
+#endif
+
+#endif
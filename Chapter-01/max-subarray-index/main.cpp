@@ -0,0 +1,28 @@
+#include <iostream>
+#include "max-subarray-index.h"
+using namespace std;
+
+/**
+ * @brief Prints a subarray as "sum [start, end)"
+ */
+void print(const Subarray& subarray)
+{
+    cout << subarray.sum << " [" << subarray.start << ", " << subarray.end << ")" << endl;
+}
+
+int main(void)
+{
+    MaxSubarrayIndex index({4, -3, 5, -2, -1, 2, 6, -2});
+    print(index.best());
+    print(index.query(1, 5));
+
+    index.update(4, -20);
+    print(index.best());
+
+    // Streaming mode: append and ask about the trailing window
+    for (int x : {3, -1, 7})
+        index.push_back(x);
+    print(index.window(4));
+    print(index.best());
+    return 0;
+}
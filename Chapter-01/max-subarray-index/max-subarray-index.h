@@ -0,0 +1,180 @@
+#ifndef MAX_SUBARRAY_INDEX_H
+#define MAX_SUBARRAY_INDEX_H
+#include <vector>
+#include <cstddef>
+#include "../maximum-subarray-sum.h"
+using namespace std;
+
+/**
+ * @brief Exception thrown when an index or range lies outside the stored values
+ */
+class IndexOutOfRangeException {};
+
+/**
+ * @class MaxSubarrayIndex
+ * @brief Segment tree answering maximum-subarray queries over a changing array.
+ *
+ * Every node stores the SubarraySummary (total, best prefix, best suffix, best) of
+ * its range, and parents are merged with combineSubarrays, the same step the
+ * divide-and-conquer maxSubarraySum uses. Leaves past the last value hold empty
+ * summaries so the tree can grow by appending.
+ */
+class MaxSubarrayIndex
+{
+private:
+    size_t theSize;                ///< Number of stored values
+    size_t theCapacity;            ///< Number of leaves (a power of two)
+    vector<int> values;            ///< The stored values
+    vector<SubarraySummary> tree;  ///< Node i has children 2i and 2i + 1; leaves start at theCapacity
+
+    /**
+     * @brief Summary of the empty range at position
+     */
+    static SubarraySummary emptyAt(size_t position)
+    {
+        return {position, position, 0, 0, position, 0, position, {0, position, position}};
+    }
+
+    /**
+     * @brief Summary of the single value at index
+     */
+    static SubarraySummary leaf(size_t index, int value)
+    {
+        SubarraySummary summary = {index, index + 1, value, 0, index, 0, index + 1, {0, index, index}};
+        if (value > 0)
+        {
+            summary.prefix = summary.suffix = value;
+            summary.prefixEnd = index + 1;
+            summary.suffixStart = index;
+            summary.best = {value, index, index + 1};
+        }
+        return summary;
+    }
+
+    /**
+     * @brief Rebuilds every node for the current capacity
+     * @note Complexity: O(capacity)
+     */
+    void rebuild()
+    {
+        tree.assign(2 * theCapacity, emptyAt(0));
+        for (size_t i = 0; i < theCapacity; i++)
+            tree[theCapacity + i] = i < theSize ? leaf(i, values[i]) : emptyAt(i);
+        for (size_t node = theCapacity - 1; node > 0; node--)
+            tree[node] = combineSubarrays(tree[2 * node], tree[2 * node + 1]);
+    }
+
+public:
+    /**
+     * @brief Builds the index over an initial array
+     * @param initial Values to index (may be empty)
+     * @note Complexity: O(N)
+     */
+    explicit MaxSubarrayIndex(const vector<int>& initial = {}) : theSize{initial.size()}, theCapacity{1}, values{initial}
+    {
+        while (theCapacity < theSize)
+            theCapacity *= 2;
+        rebuild();
+    }
+
+    /**
+     * @brief Gets the number of stored values
+     */
+    size_t size() const
+    {
+        return theSize;
+    }
+
+    /**
+     * @brief Gets the value at index
+     */
+    int operator[](size_t index) const
+    {
+        return values[index];
+    }
+
+    /**
+     * @brief Replaces the value at index
+     * @param index Position to update
+     * @param value New value
+     * @throw IndexOutOfRangeException if index >= size()
+     * @note Complexity: O(log N)
+     */
+    void update(size_t index, int value)
+    {
+        if (index >= theSize)
+            throw IndexOutOfRangeException();
+
+        values[index] = value;
+        size_t node = theCapacity + index;
+        tree[node] = leaf(index, value);
+        for (node /= 2; node > 0; node /= 2)
+            tree[node] = combineSubarrays(tree[2 * node], tree[2 * node + 1]);
+    }
+
+    /**
+     * @brief Appends a value, for streaming input
+     * @param value Value to append
+     * @note Complexity: O(log N) amortized; the tree doubles when it is full
+     */
+    void push_back(int value)
+    {
+        values.push_back(value);
+        if (theSize == theCapacity)
+        {
+            theCapacity *= 2;
+            theSize++;
+            rebuild();
+            return;
+        }
+        theSize++;
+        update(theSize - 1, value);
+    }
+
+    /**
+     * @brief Finds the maximum subarray inside [left, right)
+     * @param left First index of the range
+     * @param right One past the last index of the range
+     * @return The best subarray with absolute indices
+     * @throw IndexOutOfRangeException if left > right or right > size()
+     * @note Complexity: O(log N)
+     */
+    Subarray query(size_t left, size_t right) const
+    {
+        if (left > right || right > theSize)
+            throw IndexOutOfRangeException();
+
+        // Left and right partial results are kept apart because combining is not commutative
+        SubarraySummary leftPart = emptyAt(left), rightPart = emptyAt(right);
+        for (size_t l = left + theCapacity, r = right + theCapacity; l < r; l /= 2, r /= 2)
+        {
+            if (l & 1)
+                leftPart = combineSubarrays(leftPart, tree[l++]);
+            if (r & 1)
+                rightPart = combineSubarrays(tree[--r], rightPart);
+        }
+        return combineSubarrays(leftPart, rightPart).best;
+    }
+
+    /**
+     * @brief Finds the maximum subarray among the last length values
+     * @param length Window length; clamped to size()
+     * @note Complexity: O(log N)
+     */
+    Subarray window(size_t length) const
+    {
+        length = min(length, theSize);
+        return query(theSize - length, theSize);
+    }
+
+    /**
+     * @brief Finds the maximum subarray of all stored values
+     * @note Complexity: O(1)
+     */
+    Subarray best() const
+    {
+        return tree[1].best;
+    }
+};
+
+#endif
@@ -0,0 +1,233 @@
+#ifndef MAXIMUM_SUBARRAY_SUM_H
+#define MAXIMUM_SUBARRAY_SUM_H
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstddef>
+using namespace std;
+
+/**
+ * @brief Finds maximum subarray sum using divide and conquer
+ * @param arr Input array
+ * @param left Starting index
+ * @param right Ending index
+ * @return Maximum subarray sum in range [left, right]
+ * @note Sums are accumulated in 64 bits so large inputs do not overflow
+ */
+inline long long maxSubarraySum(const vector<int>& arr, int left, int right)
+{
+    if (left == right)
+    {
+        if (arr[left] > 0)
+            return arr[left];
+        else
+            return 0;
+    }
+
+    int center = (left + right) / 2;
+    long long maxLeftSum = maxSubarraySum(arr, left, center);
+    long long maxRightSum = maxSubarraySum(arr, center + 1, right);
+
+    long long maxLeftBorderSum = 0, leftBorderSum = 0;
+    for (int i = center; i >= left; i--)
+    {
+        leftBorderSum += arr[i];
+        if (leftBorderSum > maxLeftBorderSum)
+            maxLeftBorderSum = leftBorderSum;
+    }
+
+    long long maxRightBorderSum = 0, rightBorderSum = 0;
+    for (int i = center + 1; i <= right; i++)
+    {
+        rightBorderSum += arr[i];
+        if (rightBorderSum > maxRightBorderSum)
+            maxRightBorderSum = rightBorderSum;
+    }
+
+    return max({maxLeftSum, maxRightSum, maxLeftBorderSum + maxRightBorderSum});
+}
+
+/**
+ * @brief Finds maximum subarray sum in entire array
+ * @param arr Input array
+ * @return Maximum subarray sum (0 for an empty array)
+ */
+inline long long maxSubarraySum(const vector<int>& arr)
+{
+    if (arr.empty())
+        return 0;
+    return maxSubarraySum(arr, 0, arr.size() - 1);
+}
+
+/**
+ * @brief A subarray [start, end) together with its sum
+ *
+ * As with maxSubarraySum, the empty subarray (start == end) with sum 0 is allowed,
+ * so an array with no positive element yields sum 0.
+ */
+struct Subarray
+{
+    long long sum;
+    size_t start; ///< First index
+    size_t end;   ///< One past the last index
+};
+
+/**
+ * @brief Finds the maximum subarray with Kadane's linear scan
+ * @param arr Input array
+ * @return The first maximum-sum subarray and its bounds
+ * @note Complexity: O(N)
+ */
+inline Subarray maxSubarrayKadane(const vector<int>& arr)
+{
+    Subarray best = {0, 0, 0};
+    long long current = 0;
+    size_t currentStart = 0;
+    for (size_t i = 0; i < arr.size(); i++)
+    {
+        // A non-positive running sum can only lower what follows, so start over
+        if (current <= 0)
+        {
+            current = 0;
+            currentStart = i;
+        }
+        current += arr[i];
+        if (current > best.sum)
+            best = {current, currentStart, i + 1};
+    }
+    return best;
+}
+
+/**
+ * @brief Everything needed to merge the answers of two adjacent ranges
+ *
+ * These are the quantities the divide-and-conquer combines at each level: the total,
+ * the best sum touching the left border (prefix), the best sum touching the right
+ * border (suffix) and the best sum anywhere.
+ */
+struct SubarraySummary
+{
+    size_t begin;       ///< First index of the summarized range
+    size_t end;         ///< One past the last index of the range
+    long long total;    ///< Sum of the whole range
+    long long prefix;   ///< Best sum of [begin, prefixEnd)
+    size_t prefixEnd;
+    long long suffix;   ///< Best sum of [suffixStart, end)
+    size_t suffixStart;
+    Subarray best;      ///< Best subarray inside the range
+};
+
+/**
+ * @brief Summarizes arr[begin, end) in one pass
+ * @return The range's total, best prefix, best suffix and best subarray
+ */
+inline SubarraySummary summarizeSubarray(const vector<int>& arr, size_t begin, size_t end)
+{
+    SubarraySummary summary = {begin, end, 0, 0, begin, 0, end, {0, begin, begin}};
+    long long running = 0, minPrefix = 0, current = 0;
+    size_t minPrefixEnd = begin, currentStart = begin;
+    for (size_t i = begin; i < end; i++)
+    {
+        running += arr[i];
+        if (running > summary.prefix)
+        {
+            summary.prefix = running;
+            summary.prefixEnd = i + 1;
+        }
+        if (running < minPrefix)
+        {
+            minPrefix = running;
+            minPrefixEnd = i + 1;
+        }
+
+        if (current <= 0)
+        {
+            current = 0;
+            currentStart = i;
+        }
+        current += arr[i];
+        if (current > summary.best.sum)
+            summary.best = {current, currentStart, i + 1};
+    }
+
+    // The best suffix drops the smallest prefix
+    summary.total = running;
+    summary.suffix = running - minPrefix;
+    summary.suffixStart = summary.suffix > 0 ? minPrefixEnd : end;
+    return summary;
+}
+
+/**
+ * @brief Merges the summaries of two adjacent ranges (left immediately followed by right)
+ * @return Summary of the concatenated range
+ */
+inline SubarraySummary combineSubarrays(const SubarraySummary& left, const SubarraySummary& right)
+{
+    SubarraySummary merged;
+    merged.begin = left.begin;
+    merged.end = right.end;
+    merged.total = left.total + right.total;
+
+    merged.prefix = left.prefix;
+    merged.prefixEnd = left.prefixEnd;
+    if (left.total + right.prefix > merged.prefix)
+    {
+        merged.prefix = left.total + right.prefix;
+        merged.prefixEnd = right.prefixEnd;
+    }
+
+    merged.suffix = right.suffix;
+    merged.suffixStart = right.suffixStart;
+    if (right.total + left.suffix > merged.suffix)
+    {
+        merged.suffix = right.total + left.suffix;
+        merged.suffixStart = left.suffixStart;
+    }
+
+    // The best subarray is on one side or crosses the border
+    merged.best = left.best;
+    Subarray crossing = {left.suffix + right.prefix, left.suffixStart, right.prefixEnd};
+    if (crossing.sum > merged.best.sum)
+        merged.best = crossing;
+    if (right.best.sum > merged.best.sum)
+        merged.best = right.best;
+    return merged;
+}
+
+/**
+ * @brief Finds the maximum subarray by summarizing chunks in parallel
+ *
+ * Each thread summarizes one contiguous chunk with summarizeSubarray, and the chunk
+ * summaries are then folded left to right with combineSubarrays.
+ *
+ * @param arr Input array
+ * @param numThreads Number of threads (at least 1)
+ * @return The maximum-sum subarray and its bounds
+ * @note Complexity: O(N / numThreads + numThreads)
+ */
+inline Subarray maxSubarrayParallel(const vector<int>& arr, int numThreads)
+{
+    numThreads = (int)max<size_t>(1, min<size_t>(max(numThreads, 1), arr.size()));
+    size_t chunk = (arr.size() + numThreads - 1) / numThreads;
+
+    vector<SubarraySummary> summaries(numThreads);
+    vector<thread> workers;
+    for (int t = 1; t < numThreads; t++)
+    {
+        workers.emplace_back([&, t]()
+        {
+            size_t begin = min(arr.size(), t * chunk);
+            summaries[t] = summarizeSubarray(arr, begin, min(arr.size(), begin + chunk));
+        });
+    }
+    summaries[0] = summarizeSubarray(arr, 0, min(arr.size(), chunk));
+    for (thread& worker : workers)
+        worker.join();
+
+    SubarraySummary result = summaries[0];
+    for (int t = 1; t < numThreads; t++)
+        result = combineSubarrays(result, summaries[t]);
+    return result.best;
+}
+
+#endif
@@ -1,6 +1,10 @@
 #ifndef ORDEREDCOLLECTION_H
 #define ORDEREDCOLLECTION_H
+#include "../container-stats.h"
 
+// Shared with the other collection headers so both can be included together
+#ifndef COLLECTION_EXCEPTIONS
+#define COLLECTION_EXCEPTIONS
 /**
  * @brief Exception thrown when attempting to insert into a full collection.
  */
@@ -15,6 +19,7 @@ class EmptyCollectionException {};
  * @brief Exception thrown when an object is not found in the collection.
  */
 class ObjectNotFoundException {};
+#endif
 
 /**
  * @class OrderedCollection
@@ -22,9 +27,11 @@ class ObjectNotFoundException {};
  * * This class uses a contiguous array. It provides efficient min/max access 
  * and uses binary search for insertions and removals.
  * * @tparam Comparable Type of elements stored; must support <, >, and == operators.
+ * @note With CONTAINER_STATS defined, stats() reports the elements copied in and
+ * shifted by insert() and remove() (see container-stats.h).
  */
 template <typename Comparable>
-class OrderedCollection
+class OrderedCollection : public InstrumentedContainer
 {
 private:
     int lastPointer; ///< Index of the current last element. -1 if empty.
@@ -41,6 +48,7 @@ public:
         maxSize = size;
         lastPointer = -1;
         arr = new Comparable[maxSize];
+        countAllocation(maxSize * sizeof(Comparable));
     }
 
     // Disable copy/move semantics to prevent shallow copy issues with the raw pointer
@@ -96,6 +104,8 @@ public:
             arr[i + 1] = arr[i];
 
         arr[left] = comparable;
+        countShifts(lastPointer - left + 1);
+        countCopies(1);
         lastPointer++;
     }
 
@@ -122,6 +132,7 @@ public:
                 // Shift elements to the left to fill the gap
                 for (int j = mid + 1; j <= lastPointer; j++)
                     arr[j - 1] = arr[j];
+                countShifts(lastPointer - mid);
                 
                 lastPointer--;
                 return;
@@ -0,0 +1,61 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdio>
+#include "parallel-selection.h"
+using namespace std;
+
+/**
+ * @brief Times one call of parallelSelect
+ * @return Elapsed milliseconds
+ */
+double timeSelect(const vector<int>& numbers, size_t k, int numThreads, int& result)
+{
+    auto start = chrono::high_resolution_clock::now();
+    result = parallelSelect(numbers, k, numThreads, 42);
+    auto stop = chrono::high_resolution_clock::now();
+    return chrono::duration<double, milli>(stop - start).count();
+}
+
+/**
+ * @brief Benchmarks parallel selection of the median from 1 to maxThreads threads
+ *
+ * Usage: ./main [N] [maxThreads]
+ * Defaults to N = 10^7 and the hardware thread count. The thread count is doubled
+ * each step, and the speedup is reported against the single-threaded run.
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? stoull(argv[1]) : 10000000;
+    int maxThreads = argc > 2 ? stoi(argv[2]) : max(1u, thread::hardware_concurrency());
+    if (n < 1)
+    {
+        cout << "N must be at least 1" << endl;
+        return 1;
+    }
+
+    vector<int> numbers(n);
+    mt19937 generator(7);
+    for (size_t i = 0; i < n; i++)
+        numbers[i] = generator();
+
+    size_t k = max<size_t>(1, n / 2);
+    int result;
+    double baseline = timeSelect(numbers, k, 1, result);
+    cout << "The kth (N/2) largest element is: " << result << endl;
+
+    cout << "-------------------------------------" << endl;
+    cout << "|Threads |Time (ms)     |Speedup    |" << endl;
+    cout << "-------------------------------------" << endl;
+    for (int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        double elapsed = threads == 1 ? baseline : timeSelect(numbers, k, threads, result);
+        printf("|%-8d|%-14.1f|%-11.2f|\n", threads, elapsed, baseline / elapsed);
+    }
+    cout << "-------------------------------------" << endl;
+    return 0;
+}
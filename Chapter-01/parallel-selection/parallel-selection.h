@@ -0,0 +1,156 @@
+#ifndef PARALLEL_SELECTION_H
+#define PARALLEL_SELECTION_H
+#include <vector>
+#include <thread>
+#include <random>
+#include <algorithm>
+#include <cstddef>
+using namespace std;
+
+/**
+ * @brief Exception thrown when k is outside [1, N]
+ */
+class InvalidRankException {};
+
+/**
+ * @brief Runs body(t) for t in [0, numThreads) on separate threads and joins them.
+ * @param numThreads Number of threads (thread 0 runs on the caller)
+ * @param body Callable taking the thread index
+ */
+template <typename Body>
+void parallelFor(int numThreads, Body body)
+{
+    vector<thread> workers;
+    workers.reserve(numThreads - 1);
+    for (int t = 1; t < numThreads; t++)
+        workers.emplace_back(body, t);
+    body(0);
+    for (thread& worker : workers)
+        worker.join();
+}
+
+/**
+ * @brief Picks a pivot whose rank in the sample matches the rank of k in the data.
+ *
+ * A random sample is drawn with the given generator and the sample element at the
+ * same relative position as k is returned, so the bucket holding k shrinks quickly.
+ *
+ * @param data Elements under consideration
+ * @param n Number of elements in data
+ * @param k 1-based rank (k-th largest) being searched for
+ * @param generator Seeded random generator
+ * @return The chosen pivot
+ */
+template <typename Comparable>
+Comparable samplePivot(const Comparable* data, size_t n, size_t k, mt19937_64& generator)
+{
+    const size_t sampleSize = min<size_t>(n, 1024);
+    vector<Comparable> sample(sampleSize);
+    uniform_int_distribution<size_t> pick(0, n - 1);
+    for (size_t i = 0; i < sampleSize; i++)
+        sample[i] = data[pick(generator)];
+
+    size_t position = (k - 1) * sampleSize / n;
+    nth_element(sample.begin(), sample.begin() + position, sample.end(), greater<Comparable>());
+    return sample[position];
+}
+
+/**
+ * @brief Finds the k-th largest element using a parallel three-way partition
+ *
+ * Each round samples a pivot, lets every thread count how many of its elements are
+ * greater than, equal to and less than the pivot, turns the counts into write
+ * offsets and then scatters the chunks into a scratch buffer. Only the bucket that
+ * holds k is kept for the next round. Small ranges are finished with nth_element.
+ *
+ * The result and the work done are the same for a given seed regardless of the
+ * thread count, since the per-thread offsets preserve the input order.
+ *
+ * @param numbers Input elements (left unchanged)
+ * @param k 1-based rank, k = 1 is the maximum
+ * @param numThreads Number of worker threads (at least 1)
+ * @param seed Seed for pivot sampling
+ * @return The k-th largest element
+ * @throws InvalidRankException if k is 0 or larger than numbers.size()
+ *
+ * @note Complexity: O(N) expected work, O(N / numThreads) expected span per round
+ * @note Uses 2N extra elements of scratch space
+ */
+template <typename Comparable>
+Comparable parallelSelect(const vector<Comparable>& numbers, size_t k, int numThreads = 1, unsigned long long seed = 0)
+{
+    if (k == 0 || k > numbers.size())
+        throw InvalidRankException();
+    numThreads = max(numThreads, 1);
+
+    const size_t SEQUENTIAL_CUTOFF = 1 << 16;
+    mt19937_64 generator(seed);
+    vector<Comparable> current(numbers), next(numbers.size());
+    size_t n = numbers.size();
+
+    while (n > SEQUENTIAL_CUTOFF)
+    {
+        const Comparable pivot = samplePivot(current.data(), n, k, generator);
+        const size_t chunk = (n + numThreads - 1) / numThreads;
+
+        // Pass 1: per-thread counts of greater / equal / less elements
+        vector<size_t> greaterCount(numThreads), equalCount(numThreads), lessCount(numThreads);
+        parallelFor(numThreads, [&](int t)
+        {
+            size_t begin = min(n, t * chunk), end = min(n, begin + chunk);
+            size_t g = 0, e = 0, l = 0;
+            for (size_t i = begin; i < end; i++)
+            {
+                if (current[i] > pivot) g++;
+                else if (current[i] < pivot) l++;
+                else e++;
+            }
+            greaterCount[t] = g;
+            equalCount[t] = e;
+            lessCount[t] = l;
+        });
+
+        size_t totalGreater = 0, totalEqual = 0;
+        for (int t = 0; t < numThreads; t++)
+        {
+            totalGreater += greaterCount[t];
+            totalEqual += equalCount[t];
+        }
+
+        if (k > totalGreater && k <= totalGreater + totalEqual)
+            return pivot;
+
+        // Only the bucket holding k is scattered into the scratch buffer
+        const bool keepGreater = k <= totalGreater;
+        vector<size_t>& counts = keepGreater ? greaterCount : lessCount;
+        vector<size_t> offset(numThreads, 0);
+        for (int t = 1; t < numThreads; t++)
+            offset[t] = offset[t - 1] + counts[t - 1];
+
+        // Pass 2: each thread writes its share of the kept bucket
+        parallelFor(numThreads, [&](int t)
+        {
+            size_t begin = min(n, t * chunk), end = min(n, begin + chunk);
+            size_t out = offset[t];
+            for (size_t i = begin; i < end; i++)
+            {
+                if (keepGreater ? current[i] > pivot : current[i] < pivot)
+                    next[out++] = current[i];
+            }
+        });
+
+        if (keepGreater)
+            n = totalGreater;
+        else
+        {
+            n -= totalGreater + totalEqual;
+            k -= totalGreater + totalEqual;
+        }
+        swap(current, next);
+    }
+
+    nth_element(current.begin(), current.begin() + (k - 1), current.begin() + n, greater<Comparable>());
+    return current[k - 1];
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef PERMUTATION_H
+#define PERMUTATION_H
+#include <iostream>
+#include <string>
+using namespace std;
+
+/**
+ * @brief Recursively generates all permutations of a string
+ * @param str String to permute
+ * @param low Starting index
+ * @param high Ending index
+ * @param out Stream the permutations are written to
+ */
+inline void permute(const string& str, int low, int high, ostream& out = cout)
+{
+    if (low > high)
+    {
+        out << str << endl;
+        return;
+    }
+
+    for (int i = low; i <= high; i++)
+    {
+        string temp = str;
+        swap(temp[i], temp[low]);
+        permute(temp, low + 1, high, out);
+        swap(temp[i], temp[low]);
+    }
+}
+
+/**
+ * @brief Driver function to print all permutations of a string
+ * @param str String to permute
+ * @param out Stream the permutations are written to
+ */
+inline void permute(const string& str, ostream& out = cout)
+{
+    permute(str, 0, str.size() - 1, out);
+}
+
+#endif
@@ -0,0 +1,46 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "permutation-range.h"
+#include "permutation-rank.h"
+#include "../../Chapter-03/Vector.h"
+using namespace std;
+
+int main(void)
+{
+    // Repeated letters: each distinct arrangement is printed once
+    BufferedWriter writer(cout);
+    for (const string& word : permutations(string("aabc")))
+        writer.writeLine(word);
+    writer.flush();
+
+    Vector<int> numbers;
+    for (int x : {3, 1, 2})
+        numbers.push_back(x);
+    for (const Vector<int>& p : permutations(numbers))
+    {
+        for (int x : p)
+            cout << x << ' ';
+        cout << endl;
+    }
+
+    // Jump straight to a permutation and back
+    string letters = "abcdefghij";
+    uint64_t rank = 1234567;
+    string jumped = permutationUnrank(letters, rank);
+    cout << jumped << ' ' << permutationRank(jumped) << endl;
+    cout << permutationCount(string("mississippi")) << endl;
+
+    // Count permutations of 9 letters whose first letter is before the last, on 4 threads
+    vector<long long> perWorker(4, 0);
+    parallelForEachPermutation(string("abcdefghi"), 4, [&](const string& p, int worker)
+    {
+        if (p.front() < p.back())
+            perWorker[worker]++;
+    });
+    long long total = 0;
+    for (long long count : perWorker)
+        total += count;
+    cout << total << endl;
+    return 0;
+}
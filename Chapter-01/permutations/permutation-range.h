@@ -0,0 +1,233 @@
+#ifndef PERMUTATION_RANGE_H
+#define PERMUTATION_RANGE_H
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+/**
+ * @brief Rearranges [first, last) into the next lexicographically greater permutation
+ *
+ * Equal elements are never swapped with each other, so a range with repeated
+ * elements steps through each distinct arrangement exactly once.
+ *
+ * @param first Random-access iterator to the first element
+ * @param last Random-access iterator past the last element
+ * @param less Strict weak ordering
+ * @return false (and the range sorted ascending again) after the last permutation
+ * @note Complexity: O(N) worst case, O(1) amortized
+ */
+template <typename Iterator, typename Comparator>
+bool nextPermutation(Iterator first, Iterator last, Comparator less)
+{
+    if (last - first < 2)
+        return false;
+
+    // Find the rightmost i with items[i] < items[i + 1]
+    Iterator i = last - 1;
+    while (i != first && !less(*(i - 1), *i))
+        --i;
+    if (i == first)
+    {
+        reverse(first, last);
+        return false;
+    }
+    --i;
+
+    // Swap it with the rightmost element greater than it, then reverse the tail
+    Iterator j = last - 1;
+    while (!less(*i, *j))
+        --j;
+    iter_swap(i, j);
+    reverse(i + 1, last);
+    return true;
+}
+
+/**
+ * @class Permutations
+ * @brief Lazy range over the distinct permutations of a random-access container.
+ *
+ * The elements are copied once into an internal buffer, sorted, and then stepped in
+ * place with nextPermutation, so advancing never allocates. Dereferencing an
+ * iterator gives a reference to that shared buffer: it is overwritten by the next
+ * increment and only one iteration may be in progress at a time.
+ *
+ * @tparam Container Random-access container, e.g. string, vector<int> or Vector<char>
+ * @tparam Comparator Ordering used for sorting and for detecting duplicates
+ */
+template <typename Container, typename Comparator = less<typename decay<decltype(*declval<Container&>().begin())>::type>>
+class Permutations
+{
+private:
+    Container items;    ///< Buffer holding the current permutation
+    Comparator less;    ///< Element ordering
+
+public:
+    /**
+     * @class iterator
+     * @brief Input iterator that advances the owning range in place.
+     */
+    class iterator
+    {
+    private:
+        Permutations* owner; ///< Range being iterated, nullptr for the end iterator
+
+    public:
+        typedef input_iterator_tag iterator_category;
+        typedef Container value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const Container* pointer;
+        typedef const Container& reference;
+
+        explicit iterator(Permutations* owner = nullptr) : owner{owner}
+        {}
+
+        const Container& operator*() const
+        {
+            return owner->items;
+        }
+
+        const Container* operator->() const
+        {
+            return &owner->items;
+        }
+
+        iterator& operator++()
+        {
+            if (!nextPermutation(owner->items.begin(), owner->items.end(), owner->less))
+                owner = nullptr;
+            return *this;
+        }
+
+        bool operator==(const iterator& rhs) const
+        {
+            return owner == rhs.owner;
+        }
+
+        bool operator!=(const iterator& rhs) const
+        {
+            return owner != rhs.owner;
+        }
+    };
+
+    /**
+     * @brief Prepares the range, sorting the elements into the first permutation
+     * @param elements Elements to permute (copied once)
+     * @param less Element ordering
+     */
+    explicit Permutations(Container elements, Comparator less = Comparator{})
+        : items{std::move(elements)}, less{less}
+    {
+        sort(items.begin(), items.end(), less);
+    }
+
+    /**
+     * @brief Starts an iteration from the lexicographically smallest permutation
+     */
+    iterator begin()
+    {
+        sort(items.begin(), items.end(), less);
+        return iterator(this);
+    }
+
+    iterator end()
+    {
+        return iterator();
+    }
+};
+
+/**
+ * @brief Convenience factory for Permutations
+ * @param elements Elements to permute
+ */
+template <typename Container>
+Permutations<Container> permutations(Container elements)
+{
+    return Permutations<Container>(std::move(elements));
+}
+
+/**
+ * @class BufferedWriter
+ * @brief Collects output in a large buffer and hands it to a stream in blocks.
+ *
+ * Used for bulk permutation output instead of one endl (and one flush) per line.
+ */
+class BufferedWriter
+{
+private:
+    ostream& out;         ///< Destination stream
+    vector<char> buffer;  ///< Pending bytes
+    size_t used;          ///< Number of pending bytes
+
+public:
+    /**
+     * @brief Constructs a writer
+     * @param out Destination stream
+     * @param capacity Buffer size in bytes
+     */
+    explicit BufferedWriter(ostream& out, size_t capacity = 1 << 16) : out(out), buffer(max<size_t>(capacity, 1)), used{0}
+    {}
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    /**
+     * @brief Appends the elements of a container followed by a newline
+     * @param line Container whose elements convert to char
+     */
+    template <typename Container>
+    void writeLine(const Container& line)
+    {
+        size_t length = line.end() - line.begin();
+        if (used + length + 1 > buffer.size())
+            flush();
+        if (length + 1 > buffer.size())
+        {
+            for (const auto& element : line)
+                put(element);
+            put('\n');
+            return;
+        }
+
+        // Fast path: the whole line fits, so copy it without per-character checks
+        char* target = buffer.data() + used;
+        for (const auto& element : line)
+            *target++ = element;
+        *target = '\n';
+        used += length + 1;
+    }
+
+    /**
+     * @brief Appends one character
+     */
+    void put(char c)
+    {
+        if (used == buffer.size())
+            flush();
+        buffer[used++] = c;
+    }
+
+    /**
+     * @brief Writes every pending byte to the stream
+     */
+    void flush()
+    {
+        out.write(buffer.data(), used);
+        used = 0;
+    }
+
+    /**
+     * @brief Flushes pending bytes
+     */
+    ~BufferedWriter()
+    {
+        flush();
+    }
+};
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef PERMUTATION_RANK_H
+#define PERMUTATION_RANK_H
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <type_traits>
+#include "permutation-range.h"
+using namespace std;
+
+#ifdef __SIZEOF_INT128__
+/**
+ * @brief 128-bit rank type, enough for every permutation of up to 34 elements
+ */
+typedef unsigned __int128 Rank128;
+#endif
+
+/**
+ * @brief Exception thrown when a permutation count does not fit in the rank type
+ */
+class RankOverflowException {};
+
+/**
+ * @brief Exception thrown when a rank is not below the number of permutations
+ */
+class RankOutOfRangeException {};
+
+/**
+ * @brief Greatest common divisor of two unsigned values
+ */
+template <typename Rank>
+Rank rankGcd(Rank a, Rank b)
+{
+    while (b != 0)
+    {
+        Rank t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * @brief Computes count * numerator / denominator exactly, knowing the result is an integer
+ *
+ * Dividing out the common factor of count and denominator first means only the
+ * result itself must fit in Rank. Used for the factorial-number-system steps
+ * on multisets, where every intermediate count is a multinomial coefficient.
+ *
+ * @throw RankOverflowException if the result does not fit in Rank
+ */
+template <typename Rank>
+Rank scaleExact(Rank count, Rank numerator, Rank denominator)
+{
+    Rank g = rankGcd(count, denominator);
+    count /= g;
+    numerator /= denominator / g;
+    if (numerator != 0 && count > Rank(~Rank(0)) / numerator)
+        throw RankOverflowException();
+    return count * numerator;
+}
+
+/**
+ * @brief Sorted distinct values of a multiset and how often each occurs
+ */
+template <typename Object>
+struct Multiset
+{
+    vector<Object> values;
+    vector<size_t> counts;
+    size_t size;
+
+    template <typename Container>
+    explicit Multiset(const Container& items) : size{0}
+    {
+        vector<Object> sorted(items.begin(), items.end());
+        sort(sorted.begin(), sorted.end());
+        for (const Object& item : sorted)
+        {
+            if (values.empty() || values.back() < item)
+            {
+                values.push_back(item);
+                counts.push_back(0);
+            }
+            counts.back()++;
+            size++;
+        }
+    }
+
+    /**
+     * @brief Number of distinct arrangements, size! / (c1! * c2! * ...)
+     */
+    template <typename Rank>
+    Rank arrangements() const
+    {
+        Rank total = 1;
+        size_t placed = 0;
+        for (size_t v = 0; v < values.size(); v++)
+        {
+            // Adding one more copy of value v to a multiset of 'placed' items
+            for (size_t c = 1; c <= counts[v]; c++)
+                total = scaleExact<Rank>(total, ++placed, c);
+        }
+        return total;
+    }
+};
+
+/**
+ * @brief Counts the distinct permutations of items (n! when all items differ)
+ * @tparam Rank Unsigned integer type, e.g. uint64_t or Rank128
+ * @param items Elements, repeats allowed
+ * @throw RankOverflowException if the count does not fit in Rank
+ */
+template <typename Rank = uint64_t, typename Container>
+Rank permutationCount(const Container& items)
+{
+    typedef typename decay<decltype(*items.begin())>::type Object;
+    return Multiset<Object>(items).template arrangements<Rank>();
+}
+
+/**
+ * @brief Gives the lexicographic position of a permutation among all distinct permutations of its items
+ *
+ * Walks the factorial number system: at each position, every smaller value still
+ * available contributes the number of arrangements that start with it.
+ *
+ * @tparam Rank Unsigned integer type, e.g. uint64_t or Rank128
+ * @param permutation The permutation to rank
+ * @return Its 0-based rank, matching the order Permutations enumerates in
+ * @note Complexity: O(N * D) for D distinct values
+ */
+template <typename Rank = uint64_t, typename Container>
+Rank permutationRank(const Container& permutation)
+{
+    typedef typename decay<decltype(*permutation.begin())>::type Object;
+    Multiset<Object> remaining(permutation);
+    Rank total = remaining.template arrangements<Rank>();
+    Rank rank = 0;
+    size_t left = remaining.size;
+
+    for (const Object& item : permutation)
+    {
+        size_t v = lower_bound(remaining.values.begin(), remaining.values.end(), item) - remaining.values.begin();
+        for (size_t smaller = 0; smaller < v; smaller++)
+            if (remaining.counts[smaller] > 0)
+                rank += scaleExact<Rank>(total, remaining.counts[smaller], left);
+
+        total = scaleExact<Rank>(total, remaining.counts[v], left);
+        remaining.counts[v]--;
+        left--;
+    }
+    return rank;
+}
+
+/**
+ * @brief Builds the permutation at a given lexicographic rank
+ * @tparam Rank Unsigned integer type, e.g. uint64_t or Rank128
+ * @param items Elements to arrange, in any order (repeats allowed); overwritten and returned
+ * @param rank 0-based rank
+ * @return The rank-th distinct permutation of items in lexicographic order
+ * @throw RankOutOfRangeException if rank >= permutationCount(items)
+ * @note Complexity: O(N * D) for D distinct values
+ */
+template <typename Rank = uint64_t, typename Container>
+Container permutationUnrank(Container items, Rank rank)
+{
+    typedef typename decay<decltype(*items.begin())>::type Object;
+    Multiset<Object> remaining(items);
+    Rank total = remaining.template arrangements<Rank>();
+    if (rank >= total)
+        throw RankOutOfRangeException();
+
+    size_t left = remaining.size;
+    for (auto position = items.begin(); position != items.end(); ++position)
+    {
+        for (size_t v = 0; v < remaining.values.size(); v++)
+        {
+            if (remaining.counts[v] == 0)
+                continue;
+            Rank block = scaleExact<Rank>(total, remaining.counts[v], left);
+            if (rank < block)
+            {
+                *position = remaining.values[v];
+                total = block;
+                remaining.counts[v]--;
+                break;
+            }
+            rank -= block;
+        }
+        left--;
+    }
+    return items;
+}
+
+/**
+ * @brief Calls callback for every permutation with rank in [first, last), spread over threads
+ *
+ * The rank range is cut into chunks that idle workers claim from a shared counter.
+ * Each chunk unranks its first permutation and then steps with nextPermutation, so
+ * a crashed run can be resumed from the last completed rank and separate machines
+ * can take separate rank ranges.
+ *
+ * @param items Elements to permute (repeats allowed)
+ * @param first First rank to visit
+ * @param last One past the last rank to visit (clamped to the permutation count)
+ * @param numThreads Number of worker threads (at least 1)
+ * @param callback Called as callback(const Container& permutation, int worker) from
+ *                 the worker threads; it must be safe to call concurrently for
+ *                 different workers
+ * @param chunksPerThread How many chunks each worker gets on average
+ */
+template <typename Container, typename Callback>
+void parallelForEachPermutation(const Container& items, uint64_t first, uint64_t last, int numThreads,
+                                Callback callback, int chunksPerThread = 16)
+{
+    last = min(last, permutationCount<uint64_t>(items));
+    if (first >= last)
+        return;
+
+    numThreads = max(numThreads, 1);
+    const uint64_t span = last - first;
+    const uint64_t chunkCount = min<uint64_t>(span, (uint64_t)numThreads * max(chunksPerThread, 1));
+    atomic<uint64_t> nextChunk{0};
+
+    auto worker = [&](int id)
+    {
+        for (uint64_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+        {
+            uint64_t begin = first + span / chunkCount * chunk + min(chunk, span % chunkCount);
+            uint64_t end = begin + span / chunkCount + (chunk < span % chunkCount ? 1 : 0);
+
+            Container permutation = permutationUnrank<uint64_t>(items, begin);
+            for (uint64_t rank = begin; rank < end; rank++)
+            {
+                callback(static_cast<const Container&>(permutation), id);
+                nextPermutation(permutation.begin(), permutation.end(),
+                                less<typename decay<decltype(*items.begin())>::type>());
+            }
+        }
+    };
+
+    vector<thread> workers;
+    for (int t = 1; t < numThreads; t++)
+        workers.emplace_back(worker, t);
+    worker(0);
+    for (thread& w : workers)
+        w.join();
+}
+
+/**
+ * @brief Calls callback for every distinct permutation of items, spread over threads
+ */
+template <typename Container, typename Callback>
+void parallelForEachPermutation(const Container& items, int numThreads, Callback callback)
+{
+    parallelForEachPermutation(items, 0, numeric_limits<uint64_t>::max(), numThreads, callback);
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include "rectangle-set.h"
+#include "pareto-frontier.h"
+using namespace std;
+
+// Built for any x86-64; the kernels choose their vector width at run time (see rectangle-set.h)
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+/**
+ * @brief Runs the rectangle queries on a RectangleSet
+ *
+ * Usage: ./main [count]
+ * Repeats the findMax example from rectangles.cpp and prints the Pareto
+ * frontiers of the same rectangles, then times the arg-max, top-k, sum and
+ * frontier queries on count random rectangles (default 10 million; 0 skips them).
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    RectangleSet small({{10, 20}, {30, 40}, {50, 50}, {2, 2}, {100, 2}});
+    Rectangle maxArea = small[small.argMax(AreaComparator{})];
+    cout << maxArea.getLength() << ' ' << maxArea.getWidth() << endl;
+    Rectangle maxPerimeter = small[small.argMax(PerimeterComparator{})];
+    cout << maxPerimeter.getLength() << ' ' << maxPerimeter.getWidth() << endl;
+    cout << "by area:";
+    for (size_t index : small.topK(small.size(), AreaComparator{}))
+        cout << ' ' << small[index].getLength() << 'x' << small[index].getWidth();
+    cout << endl;
+    cout << "undominated on (length, width):";
+    for (size_t index : paretoFrontierBySides(small))
+        cout << ' ' << small[index].getLength() << 'x' << small[index].getWidth();
+    cout << endl;
+    cout << "undominated on (area, perimeter):";
+    for (size_t index : paretoFrontierByAreaPerimeter(small))
+        cout << ' ' << small[index].getLength() << 'x' << small[index].getWidth();
+    cout << endl;
+
+    size_t count = argc > 1 ? stoull(argv[1]) : 10000000;
+    if (count == 0)
+        return 0;
+    int threads = max(1u, thread::hardware_concurrency());
+    mt19937 generator(4);
+    uniform_real_distribution<double> side(1, 1000);
+    RectangleSet rectangles;
+    rectangles.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        rectangles.add(side(generator), side(generator));
+
+    auto start = chrono::high_resolution_clock::now();
+    size_t largest = rectangles.argMax(AreaComparator{}, threads);
+    size_t smallest = rectangles.argMin(PerimeterComparator{}, threads);
+    vector<size_t> top = rectangles.topK(10, AreaComparator{}, threads);
+    double total = rectangles.sumBy(ComparatorKey<AreaComparator>{}, threads);
+    vector<size_t> sides = paretoFrontierBySides(rectangles, threads);
+    vector<size_t> areaPerimeter = paretoFrontierByAreaPerimeter(rectangles, threads);
+    auto stop = chrono::high_resolution_clock::now();
+
+    ParetoFrontier incremental;
+    for (size_t i = 0; i < count; i++)
+        incremental.insert(rectangles[i].getLength(), rectangles[i].getWidth(), i);
+
+    printf("largest area: #%zu, smallest perimeter: #%zu, 10th largest area: %.1f\n", largest, smallest,
+           AreaComparator::key(rectangles[top.back()].getLength(), rectangles[top.back()].getWidth()));
+    printf("frontiers: %zu on (length, width), %zu on (area, perimeter), %zu kept by insertion\n", sides.size(),
+           areaPerimeter.size(), incremental.size());
+    printf("total area: %.4g, %zu rectangles on %d threads in %.1f ms\n", total, count, threads,
+           chrono::duration<double, milli>(stop - start).count());
+    return 0;
+}
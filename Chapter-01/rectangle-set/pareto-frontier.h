@@ -0,0 +1,272 @@
+#ifndef PARETO_FRONTIER_H
+#define PARETO_FRONTIER_H
+#include <vector>
+#include <set>
+#include <thread>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include "rectangle-set.h"
+using namespace std;
+
+/**
+ * @brief One rectangle projected onto two criteria, both to be maximized
+ */
+struct FrontierPoint
+{
+    double x;     ///< First criterion, e.g. length or area
+    double y;     ///< Second criterion, e.g. width or perimeter
+    size_t index; ///< Index of the rectangle in its collection
+};
+
+/**
+ * @brief Frontier order: x descending, then y descending, then index ascending
+ *
+ * Along a frontier in this order y ascends, so the points dominating (x, y) are
+ * found with one binary search on x.
+ */
+struct FrontierOrder
+{
+    bool operator()(const FrontierPoint& point1, const FrontierPoint& point2) const
+    {
+        if (point1.x != point2.x)
+            return point1.x > point2.x;
+        if (point1.y != point2.y)
+            return point1.y > point2.y;
+        return point1.index < point2.index;
+    }
+};
+
+/**
+ * @brief Tells whether a point with criteria (x, y) is dominated by a frontier point
+ * @param best Frontier point with the greatest y among those with x >= the point's x
+ *
+ * Equal points do not dominate each other, so duplicates all stay on the frontier.
+ */
+inline bool frontierDominates(const FrontierPoint& best, double x, double y)
+{
+    return best.y > y || (best.y == y && best.x > x);
+}
+
+/**
+ * @brief Reduces points to their Pareto frontier in place
+ * @param points Any points; on return, the undominated ones in FrontierOrder
+ *
+ * Sorts, then sweeps keeping each point whose y beats every point before it (or
+ * repeats the last kept point). O(n log n).
+ */
+inline void reduceToFrontier(vector<FrontierPoint>& points)
+{
+    sort(points.begin(), points.end(), FrontierOrder{});
+    size_t kept = 0;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        const FrontierPoint& point = points[i];
+        if (kept == 0 || point.y > points[kept - 1].y ||
+            (point.x == points[kept - 1].x && point.y == points[kept - 1].y))
+            points[kept++] = point;
+    }
+    points.resize(kept);
+}
+
+/**
+ * @brief Tells whether (x, y) is dominated by a frontier held in a vector in FrontierOrder
+ */
+inline bool frontierDominates(const vector<FrontierPoint>& frontier, double x, double y)
+{
+    // First point with a smaller x; the one before it has the greatest y among x' >= x
+    auto after = partition_point(frontier.begin(), frontier.end(),
+                                 [x](const FrontierPoint& point) { return point.x >= x; });
+    return after != frontier.begin() && frontierDominates(*(after - 1), x, y);
+}
+
+/**
+ * @brief Frontier of the rectangles in [first, last)
+ *
+ * Projects the range one block of keys at a time (vectorized, as in RectangleSet),
+ * discards every point dominated by the frontier of an evenly spaced sample, and
+ * reduces the survivors. On anything but adversarial data the sample frontier
+ * removes nearly all points before the sort.
+ */
+template <typename KeyX, typename KeyY>
+vector<FrontierPoint> rangeFrontier(const RectangleSet& rectangles, size_t first, size_t last, KeyX keyX, KeyY keyY)
+{
+    const size_t SAMPLE = 4096, BLOCK = 1024;
+    vector<FrontierPoint> sample;
+    size_t stride = max<size_t>(1, (last - first) / SAMPLE);
+    for (size_t i = first; i < last; i += stride)
+    {
+        Rectangle rectangle = rectangles[i];
+        sample.push_back({keyX(rectangle.getLength(), rectangle.getWidth()),
+                          keyY(rectangle.getLength(), rectangle.getWidth()), i});
+    }
+    double minX = numeric_limits<double>::infinity(), minY = minX;
+    for (const FrontierPoint& point : sample)
+    {
+        minX = min(minX, point.x);
+        minY = min(minY, point.y);
+    }
+    reduceToFrontier(sample);
+
+    // The sample frontier point spanning the largest box over the sample minimum
+    // dominates most points on its own, so it is tested first without a search
+    FrontierPoint pivot = sample.empty() ? FrontierPoint{minX, minY, 0} : sample[0];
+    for (const FrontierPoint& point : sample)
+        if ((point.x - minX) * (point.y - minY) > (pivot.x - minX) * (pivot.y - minY))
+            pivot = point;
+
+    vector<FrontierPoint> candidates;
+    vector<double> xs(BLOCK), ys(BLOCK);
+    for (size_t start = first; start < last; start += BLOCK)
+    {
+        size_t end = min(last, start + BLOCK);
+        runKernel<KeysKernel<KeyX>>(rectangles.lengthData(), rectangles.widthData(), start, end, keyX, xs.data());
+        runKernel<KeysKernel<KeyY>>(rectangles.lengthData(), rectangles.widthData(), start, end, keyY, ys.data());
+        for (size_t i = 0; i < end - start; i++)
+            if (!(xs[i] <= pivot.x && ys[i] <= pivot.y && (xs[i] < pivot.x || ys[i] < pivot.y)) &&
+                !frontierDominates(sample, xs[i], ys[i]))
+                candidates.push_back({xs[i], ys[i], start + i});
+    }
+    reduceToFrontier(candidates);
+    return candidates;
+}
+
+/**
+ * @brief Indices of the rectangles not dominated on (keyX, keyY), both maximized
+ * @param rectangles Rectangles to search
+ * @param keyX First criterion as a projection key(length, width)
+ * @param keyY Second criterion as a projection key(length, width)
+ * @param numThreads Threads sharing the work
+ * @return Frontier indices in order of decreasing keyX (increasing keyY)
+ *
+ * Divide and conquer: each thread reduces a contiguous range to its frontier, then
+ * the union of the range frontiers is reduced once more. A point undominated in
+ * the whole set is undominated in its range, so nothing is lost in the split.
+ */
+template <typename KeyX, typename KeyY>
+vector<size_t> paretoFrontier(const RectangleSet& rectangles, KeyX keyX, KeyY keyY, int numThreads = 1)
+{
+    size_t n = rectangles.size();
+    numThreads = max(1, (int)min<size_t>(numThreads, max<size_t>(n / 65536, 1)));
+    vector<vector<FrontierPoint>> frontiers(numThreads);
+    vector<thread> workers;
+    auto run = [&](int t)
+    {
+        frontiers[t] = rangeFrontier(rectangles, n * t / numThreads, n * (t + 1) / numThreads, keyX, keyY);
+    };
+    for (int t = 1; t < numThreads; t++)
+        workers.emplace_back(run, t);
+    run(0);
+    for (thread& worker : workers)
+        worker.join();
+
+    vector<FrontierPoint> points;
+    for (const vector<FrontierPoint>& frontier : frontiers)
+        points.insert(points.end(), frontier.begin(), frontier.end());
+    if (numThreads > 1)
+        reduceToFrontier(points);
+
+    vector<size_t> indices;
+    indices.reserve(points.size());
+    for (const FrontierPoint& point : points)
+        indices.push_back(point.index);
+    return indices;
+}
+
+// The projections below run on RectangleLanes, as the kernels do (see rectangle-set.h)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+/**
+ * @brief Rectangles not dominated on (length, width)
+ */
+inline vector<size_t> paretoFrontierBySides(const RectangleSet& rectangles, int numThreads = 1)
+{
+    return paretoFrontier(rectangles, [](const auto& length, const auto&) { return length; },
+                          [](const auto&, const auto& width) { return width; }, numThreads);
+}
+
+/**
+ * @brief Rectangles not dominated on (area, perimeter)
+ */
+inline vector<size_t> paretoFrontierByAreaPerimeter(const RectangleSet& rectangles, int numThreads = 1)
+{
+    return paretoFrontier(rectangles, ComparatorKey<AreaComparator>{}, ComparatorKey<PerimeterComparator>{}, numThreads);
+}
+
+#pragma GCC diagnostic pop
+
+/**
+ * @class ParetoFrontier
+ * @brief Frontier maintained under insertions
+ *
+ * Points are kept in FrontierOrder, so an insertion costs one search to test
+ * dominance plus the removal of the points it dominates, which form a contiguous
+ * run right after it: O(log n) amortized.
+ */
+class ParetoFrontier
+{
+private:
+    set<FrontierPoint, FrontierOrder> points;
+
+public:
+    /**
+     * @brief Tells whether (x, y) is dominated by the current frontier
+     */
+    bool dominates(double x, double y) const
+    {
+        // First point with x' < x; the one before it has the greatest y among x' >= x
+        auto after = points.lower_bound({x, -numeric_limits<double>::infinity(), SIZE_MAX});
+        return after != points.begin() && frontierDominates(*prev(after), x, y);
+    }
+
+    /**
+     * @brief Adds a point and drops the points it dominates
+     * @return true if the point joined the frontier
+     */
+    bool insert(double x, double y, size_t index)
+    {
+        if (dominates(x, y))
+            return false;
+        // Points with x' <= x start here; y' ascends from here, so the dominated ones lead
+        auto it = points.lower_bound({x, numeric_limits<double>::infinity(), 0});
+        while (it != points.end() && it->y <= y)
+        {
+            if (it->x == x && it->y == y)
+                ++it;
+            else
+                it = points.erase(it);
+        }
+        points.insert({x, y, index});
+        return true;
+    }
+
+    size_t size() const
+    {
+        return points.size();
+    }
+
+    bool empty() const
+    {
+        return points.empty();
+    }
+
+    /**
+     * @brief Frontier indices in order of decreasing x (increasing y)
+     */
+    vector<size_t> indices() const
+    {
+        vector<size_t> result;
+        result.reserve(points.size());
+        for (const FrontierPoint& point : points)
+            result.push_back(point.index);
+        return result;
+    }
+
+    const set<FrontierPoint, FrontierOrder>& frontier() const
+    {
+        return points;
+    }
+};
+
+#endif
@@ -0,0 +1,557 @@
+#ifndef RECTANGLE_SET_H
+#define RECTANGLE_SET_H
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "../rectangles.h"
+using namespace std;
+
+
+/**
+ * @brief Exception thrown when searching an empty RectangleSet
+ */
+class EmptyRectangleSetException {};
+
+/**
+ * @brief Doubles processed together by the vectorized kernels
+ */
+const size_t RECTANGLE_LANES = 8;
+
+// The kernels pass RectangleLanes by value, which GCC notes as an ABI change on every
+// use when the translation unit is not built with AVX-512; the kernels are inlined
+// into their dispatch wrappers, so no such value crosses a call boundary. GCC repeats
+// the note for template instantiations at the end of the translation unit, where no
+// header can scope it, so programs built without -mavx512f also pass -Wno-psabi or
+// ignore it at file scope, as main.cpp does.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+/**
+ * @brief Eight doubles as one GCC/Clang vector; arithmetic and comparisons work lane by lane
+ */
+typedef double RectangleLanes __attribute__((vector_size(RECTANGLE_LANES * sizeof(double))));
+
+/**
+ * @brief Eight 64-bit indices (and comparison masks) matching RectangleLanes
+ */
+typedef int64_t RectangleIndexLanes __attribute__((vector_size(RECTANGLE_LANES * sizeof(int64_t))));
+
+/**
+ * @brief Allocator returning 64-byte aligned storage, so vector loads never split cache lines
+ */
+template <typename Object>
+struct AlignedAllocator
+{
+    typedef Object value_type;
+
+    AlignedAllocator() = default;
+
+    template <typename Other>
+    AlignedAllocator(const AlignedAllocator<Other>&)
+    {}
+
+    Object* allocate(size_t count)
+    {
+        void* memory = aligned_alloc(64, (count * sizeof(Object) + 63) / 64 * 64);
+        if (memory == nullptr)
+            throw bad_alloc();
+        return static_cast<Object*>(memory);
+    }
+
+    void deallocate(Object* memory, size_t)
+    {
+        free(memory);
+    }
+
+    template <typename Other>
+    bool operator==(const AlignedAllocator<Other>&) const
+    {
+        return true;
+    }
+
+    template <typename Other>
+    bool operator!=(const AlignedAllocator<Other>&) const
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief Adapts a comparator's static key(length, width) to a projection object
+ */
+template <typename Comparator>
+struct ComparatorKey
+{
+    template <typename Value>
+    __attribute__((always_inline)) Value operator()(const Value& length, const Value& width) const
+    {
+        return Comparator::key(length, width);
+    }
+};
+
+/**
+ * @brief Detects comparators that expose a static key(length, width), like AreaComparator
+ */
+template <typename Comparator, typename = void>
+struct HasRectangleKey : false_type {};
+
+template <typename Comparator>
+struct HasRectangleKey<Comparator, decltype((void)Comparator::key(0.0, 0.0))> : true_type {};
+
+/**
+ * @brief Detects projections that can be evaluated on RectangleLanes as well as on doubles
+ */
+template <typename Key>
+struct IsLaneKey : is_invocable_r<RectangleLanes, Key, RectangleLanes, RectangleLanes> {};
+
+/**
+ * @brief Index and key of the best rectangle in a range
+ */
+struct RectangleBest
+{
+    size_t index;
+    double key;
+};
+
+/**
+ * @brief Loads eight doubles from any address
+ */
+inline RectangleLanes loadLanes(const double* values)
+{
+    RectangleLanes lanes;
+    memcpy(&lanes, values, sizeof(lanes));
+    return lanes;
+}
+
+/**
+ * @brief Finds the rectangle with the greatest (or least) key in [first, last), first index on ties
+ *
+ * With a lane key, each lane keeps its own best key and index and the lanes are
+ * merged at the end; the remainder is handled one rectangle at a time.
+ */
+template <bool Greatest, typename Key>
+struct BestKernel
+{
+    __attribute__((always_inline)) static inline RectangleBest run(const double* lengths, const double* widths,
+                                                                   size_t first, size_t last, Key key)
+    {
+        RectangleBest best = {first, key(lengths[first], widths[first])};
+        size_t i = first + 1;
+        if constexpr (IsLaneKey<Key>::value)
+        {
+            if (last - first >= RECTANGLE_LANES)
+            {
+                RectangleIndexLanes index = {0, 1, 2, 3, 4, 5, 6, 7};
+                index += (int64_t)first;
+                RectangleIndexLanes bestIndex = index;
+                RectangleLanes bestKeys = key(loadLanes(lengths + first), loadLanes(widths + first));
+                for (i = first + RECTANGLE_LANES; i + RECTANGLE_LANES <= last; i += RECTANGLE_LANES)
+                {
+                    index += (int64_t)RECTANGLE_LANES;
+                    RectangleLanes keys = key(loadLanes(lengths + i), loadLanes(widths + i));
+                    RectangleIndexLanes better = Greatest ? keys > bestKeys : keys < bestKeys;
+                    bestKeys = better ? keys : bestKeys;
+                    bestIndex = better ? index : bestIndex;
+                }
+
+                best = {(size_t)bestIndex[0], bestKeys[0]};
+                for (size_t lane = 1; lane < RECTANGLE_LANES; lane++)
+                {
+                    bool better = Greatest ? bestKeys[lane] > best.key : bestKeys[lane] < best.key;
+                    if (better || (bestKeys[lane] == best.key && (size_t)bestIndex[lane] < best.index))
+                        best = {(size_t)bestIndex[lane], bestKeys[lane]};
+                }
+            }
+        }
+        for (; i < last; i++)
+        {
+            double value = key(lengths[i], widths[i]);
+            if (Greatest ? value > best.key : value < best.key)
+                best = {i, value};
+        }
+        return best;
+    }
+};
+
+/**
+ * @brief Writes the keys of [first, last) to out
+ */
+template <typename Key>
+struct KeysKernel
+{
+    __attribute__((always_inline)) static inline void run(const double* lengths, const double* widths,
+                                                          size_t first, size_t last, Key key, double* out)
+    {
+        size_t i = first;
+        if constexpr (IsLaneKey<Key>::value)
+        {
+            for (; i + RECTANGLE_LANES <= last; i += RECTANGLE_LANES)
+            {
+                RectangleLanes keys = key(loadLanes(lengths + i), loadLanes(widths + i));
+                memcpy(out + (i - first), &keys, sizeof(keys));
+            }
+        }
+        for (; i < last; i++)
+            out[i - first] = key(lengths[i], widths[i]);
+    }
+};
+
+/**
+ * @brief Sums the keys of [first, last)
+ */
+template <typename Key>
+struct SumKernel
+{
+    __attribute__((always_inline)) static inline double run(const double* lengths, const double* widths,
+                                                            size_t first, size_t last, Key key)
+    {
+        double sum = 0;
+        size_t i = first;
+        if constexpr (IsLaneKey<Key>::value)
+        {
+            RectangleLanes total = {};
+            for (; i + RECTANGLE_LANES <= last; i += RECTANGLE_LANES)
+                total += key(loadLanes(lengths + i), loadLanes(widths + i));
+            for (size_t lane = 0; lane < RECTANGLE_LANES; lane++)
+                sum += total[lane];
+        }
+        for (; i < last; i++)
+            sum += key(lengths[i], widths[i]);
+        return sum;
+    }
+};
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define RECTANGLE_SET_X86 1
+
+template <typename Kernel, typename... Args>
+__attribute__((target("avx512f"))) auto runKernelAVX512(Args... args)
+{
+    return Kernel::run(args...);
+}
+
+template <typename Kernel, typename... Args>
+__attribute__((target("avx2"))) auto runKernelAVX2(Args... args)
+{
+    return Kernel::run(args...);
+}
+#endif
+
+/**
+ * @brief Runs a kernel compiled for the widest vector instructions the CPU supports
+ */
+template <typename Kernel, typename... Args>
+auto runKernel(Args... args)
+{
+#ifdef RECTANGLE_SET_X86
+    static const int level = __builtin_cpu_supports("avx512f") ? 2 : __builtin_cpu_supports("avx2") ? 1 : 0;
+    if (level == 2)
+        return runKernelAVX512<Kernel>(args...);
+    if (level == 1)
+        return runKernelAVX2<Kernel>(args...);
+#endif
+    return Kernel::run(args...);
+}
+
+#pragma GCC diagnostic pop
+
+/**
+ * @class RectangleSet
+ * @brief Rectangles stored as two aligned arrays of lengths and widths.
+ *
+ * Searches take either a comparator or a key projection. A comparator with a static
+ * key(length, width), like AreaComparator and PerimeterComparator, and a projection
+ * that accepts RectangleLanes as well as doubles (arithmetic only, e.g. a generic
+ * lambda) are evaluated eight rectangles at a time with AVX-512, AVX2 or SSE2 as the
+ * CPU allows. Other comparators and projections fall back to one rectangle at a time.
+ * Ties go to the lowest index, as in findMax.
+ */
+class RectangleSet
+{
+private:
+    vector<double, AlignedAllocator<double>> lengths;
+    vector<double, AlignedAllocator<double>> widths;
+
+    /**
+     * @brief Splits [0, size()) into contiguous chunks, runs body(first, last, t) on each and returns the results
+     */
+    template <typename Result, typename Body>
+    vector<Result> forEachChunk(int numThreads, Body body) const
+    {
+        numThreads = max(1, (int)min<size_t>(numThreads, max<size_t>(size() / 4096, 1)));
+        vector<Result> results(numThreads);
+        vector<thread> workers;
+        auto run = [&](int t)
+        {
+            results[t] = body(size() * t / numThreads, size() * (t + 1) / numThreads);
+        };
+        for (int t = 1; t < numThreads; t++)
+            workers.emplace_back(run, t);
+        run(0);
+        for (thread& worker : workers)
+            worker.join();
+        return results;
+    }
+
+    template <bool Greatest, typename Key>
+    size_t bestByKey(Key key, int numThreads) const
+    {
+        if (empty())
+            throw EmptyRectangleSetException();
+        vector<RectangleBest> bests = forEachChunk<RectangleBest>(numThreads, [&](size_t first, size_t last)
+        {
+            return runKernel<BestKernel<Greatest, Key>>(lengths.data(), widths.data(), first, last, key);
+        });
+
+        // Chunks are in index order, so a strict comparison keeps the first of equal keys
+        RectangleBest best = bests[0];
+        for (const RectangleBest& candidate : bests)
+            if (Greatest ? candidate.key > best.key : candidate.key < best.key)
+                best = candidate;
+        return best.index;
+    }
+
+    template <bool Greatest, typename Comparator>
+    size_t bestByComparator(Comparator isGreater, int numThreads) const
+    {
+        if (empty())
+            throw EmptyRectangleSetException();
+        vector<size_t> bests = forEachChunk<size_t>(numThreads, [&](size_t first, size_t last)
+        {
+            size_t best = first;
+            for (size_t i = first + 1; i < last; i++)
+                if (Greatest ? isGreater((*this)[i], (*this)[best]) : isGreater((*this)[best], (*this)[i]))
+                    best = i;
+            return best;
+        });
+
+        size_t best = bests[0];
+        for (size_t candidate : bests)
+            if (Greatest ? isGreater((*this)[candidate], (*this)[best]) : isGreater((*this)[best], (*this)[candidate]))
+                best = candidate;
+        return best;
+    }
+
+public:
+    RectangleSet() = default;
+
+    /**
+     * @brief Copies rectangles into the two arrays
+     */
+    explicit RectangleSet(const vector<Rectangle>& rectangles)
+    {
+        reserve(rectangles.size());
+        for (const Rectangle& rectangle : rectangles)
+            push_back(rectangle);
+    }
+
+    void reserve(size_t capacity)
+    {
+        lengths.reserve(capacity);
+        widths.reserve(capacity);
+    }
+
+    void push_back(const Rectangle& rectangle)
+    {
+        add(rectangle.getLength(), rectangle.getWidth());
+    }
+
+    void add(double length, double width)
+    {
+        lengths.push_back(length);
+        widths.push_back(width);
+    }
+
+    size_t size() const
+    {
+        return lengths.size();
+    }
+
+    bool empty() const
+    {
+        return lengths.empty();
+    }
+
+    Rectangle operator[](size_t index) const
+    {
+        return Rectangle(lengths[index], widths[index]);
+    }
+
+    const double* lengthData() const
+    {
+        return lengths.data();
+    }
+
+    const double* widthData() const
+    {
+        return widths.data();
+    }
+
+    /**
+     * @brief Index of the greatest rectangle, like findMax
+     * @param isGreater Comparator in the AreaComparator style
+     * @param numThreads Threads sharing the scan
+     * @throw EmptyRectangleSetException if the set is empty
+     */
+    template <typename Comparator>
+    size_t argMax(Comparator isGreater, int numThreads = 1) const
+    {
+        if constexpr (HasRectangleKey<Comparator>::value)
+            return bestByKey<true>(ComparatorKey<Comparator>{}, numThreads);
+        else
+            return bestByComparator<true>(isGreater, numThreads);
+    }
+
+    /**
+     * @brief Index of the least rectangle under the comparator
+     */
+    template <typename Comparator>
+    size_t argMin(Comparator isGreater, int numThreads = 1) const
+    {
+        if constexpr (HasRectangleKey<Comparator>::value)
+            return bestByKey<false>(ComparatorKey<Comparator>{}, numThreads);
+        else
+            return bestByComparator<false>(isGreater, numThreads);
+    }
+
+    /**
+     * @brief Index of the rectangle with the greatest key(length, width)
+     */
+    template <typename Key>
+    size_t argMaxBy(Key key, int numThreads = 1) const
+    {
+        return bestByKey<true>(key, numThreads);
+    }
+
+    /**
+     * @brief Index of the rectangle with the least key(length, width)
+     */
+    template <typename Key>
+    size_t argMinBy(Key key, int numThreads = 1) const
+    {
+        return bestByKey<false>(key, numThreads);
+    }
+
+    /**
+     * @brief Sum of key(length, width) over the set, e.g. the total area
+     */
+    template <typename Key>
+    double sumBy(Key key, int numThreads = 1) const
+    {
+        vector<double> sums = forEachChunk<double>(numThreads, [&](size_t first, size_t last)
+        {
+            return runKernel<SumKernel<Key>>(lengths.data(), widths.data(), first, last, key);
+        });
+        double total = 0;
+        for (double sum : sums)
+            total += sum;
+        return total;
+    }
+
+    /**
+     * @brief Indices of the k rectangles with the greatest keys, best first (lower index first on ties)
+     *
+     * Keys are computed a block at a time into a small buffer, and only keys that beat
+     * the current k-th best touch the heap.
+     *
+     * @note Complexity: O(n + m log k) for m heap insertions
+     */
+    template <typename Key>
+    vector<size_t> topKBy(size_t k, Key key, int numThreads = 1) const
+    {
+        // The heap's front is the worst of the k best seen so far
+        auto better = [](const RectangleBest& a, const RectangleBest& b)
+        {
+            return a.key > b.key || (a.key == b.key && a.index < b.index);
+        };
+        vector<vector<RectangleBest>> heaps = forEachChunk<vector<RectangleBest>>(numThreads, [&](size_t first, size_t last)
+        {
+            const size_t block = 1024;
+            vector<double, AlignedAllocator<double>> keys(block);
+            vector<RectangleBest> heap;
+            for (size_t start = first; start < last && k > 0; start += block)
+            {
+                size_t end = min(last, start + block);
+                runKernel<KeysKernel<Key>>(lengths.data(), widths.data(), start, end, key, keys.data());
+
+                for (size_t i = start; i < end; i++)
+                {
+                    RectangleBest candidate = {i, keys[i - start]};
+                    if (heap.size() < k)
+                    {
+                        heap.push_back(candidate);
+                        push_heap(heap.begin(), heap.end(), better);
+                    }
+                    else if (better(candidate, heap.front()))
+                    {
+                        pop_heap(heap.begin(), heap.end(), better);
+                        heap.back() = candidate;
+                        push_heap(heap.begin(), heap.end(), better);
+                    }
+                }
+            }
+            return heap;
+        });
+
+        vector<RectangleBest> merged;
+        for (const vector<RectangleBest>& heap : heaps)
+            merged.insert(merged.end(), heap.begin(), heap.end());
+        sort(merged.begin(), merged.end(), better);
+        merged.resize(min(k, merged.size()));
+
+        vector<size_t> indices;
+        for (const RectangleBest& entry : merged)
+            indices.push_back(entry.index);
+        return indices;
+    }
+
+    /**
+     * @brief Indices of the k greatest rectangles under the comparator, greatest first
+     */
+    template <typename Comparator>
+    vector<size_t> topK(size_t k, Comparator isGreater, int numThreads = 1) const
+    {
+        if constexpr (HasRectangleKey<Comparator>::value)
+            return topKBy(k, ComparatorKey<Comparator>{}, numThreads);
+        else
+        {
+            auto better = [&](size_t a, size_t b)
+            {
+                return isGreater((*this)[a], (*this)[b]) || (!isGreater((*this)[b], (*this)[a]) && a < b);
+            };
+            vector<vector<size_t>> heaps = forEachChunk<vector<size_t>>(numThreads, [&](size_t first, size_t last)
+            {
+                vector<size_t> heap;
+                for (size_t i = first; i < last && k > 0; i++)
+                {
+                    if (heap.size() < k)
+                    {
+                        heap.push_back(i);
+                        push_heap(heap.begin(), heap.end(), better);
+                    }
+                    else if (better(i, heap.front()))
+                    {
+                        pop_heap(heap.begin(), heap.end(), better);
+                        heap.back() = i;
+                        push_heap(heap.begin(), heap.end(), better);
+                    }
+                }
+                return heap;
+            });
+
+            vector<size_t> merged;
+            for (const vector<size_t>& heap : heaps)
+                merged.insert(merged.end(), heap.begin(), heap.end());
+            sort(merged.begin(), merged.end(), better);
+            merged.resize(min(k, merged.size()));
+            return merged;
+        }
+    }
+};
+
+#endif
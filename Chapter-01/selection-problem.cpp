@@ -1,26 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <chrono>
+#include "selection-problem.h"
 using namespace std;
 
-
-void selectionSort(vector<int>& numbers)
-{
-    for (int i = 0; i < numbers.size(); i++)
-    {
-        int max_element = numbers[i], max_position = i;
-        for (int j = i + 1; j < numbers.size(); j++)
-        {
-            if (numbers[j] > max_element)
-            {
-                max_element = numbers[j];
-                max_position = j;
-            }
-            swap(numbers[max_position], numbers[i]);
-        }
-    }
-}
-
 int main(void)
 {
     int n = 100000;
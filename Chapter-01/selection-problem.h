@@ -0,0 +1,29 @@
+#ifndef SELECTION_PROBLEM_H
+#define SELECTION_PROBLEM_H
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+/**
+ * @brief Sorts numbers in descending order by repeatedly selecting the maximum
+ * @param numbers Array to sort in place
+ * @note Complexity: O(N^2)
+ */
+inline void selectionSort(vector<int>& numbers)
+{
+    for (int i = 0; i < numbers.size(); i++)
+    {
+        int max_element = numbers[i], max_position = i;
+        for (int j = i + 1; j < numbers.size(); j++)
+        {
+            if (numbers[j] > max_element)
+            {
+                max_element = numbers[j];
+                max_position = j;
+            }
+        }
+        swap(numbers[max_position], numbers[i]);
+    }
+}
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef GRID_FILE_H
+#define GRID_FILE_H
+#include <vector>
+#include <string>
+#include <thread>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "word-trie.h"
+using namespace std;
+
+/**
+ * @brief Exception thrown when a grid file cannot be read, its rows differ in length or are empty
+ */
+class GridFileException {};
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Falls back to reading the file into memory on platforms without mmap.
+ */
+class MappedFile
+{
+private:
+    const char* bytes;  ///< Start of the file contents
+    size_t length;      ///< File size in bytes
+    vector<char> copy;  ///< Contents when mmap is unavailable
+
+public:
+    /**
+     * @brief Maps a file
+     * @param path File to map
+     * @throw GridFileException if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const string& path) : bytes{nullptr}, length{0}
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw GridFileException();
+        struct stat info;
+        if (fstat(fd, &info) != 0)
+        {
+            close(fd);
+            throw GridFileException();
+        }
+        length = info.st_size;
+        if (length > 0)
+        {
+            void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                close(fd);
+                throw GridFileException();
+            }
+            // The grid is read front to back once
+            madvise(mapping, length, MADV_SEQUENTIAL);
+            bytes = static_cast<const char*>(mapping);
+        }
+        close(fd);
+#else
+        ifstream in(path, ios::binary);
+        if (!in)
+            throw GridFileException();
+        copy.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        bytes = copy.data();
+        length = copy.size();
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const
+    {
+        return bytes;
+    }
+
+    size_t size() const
+    {
+        return length;
+    }
+
+    ~MappedFile()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        if (bytes != nullptr)
+            munmap(const_cast<char*>(bytes), length);
+#endif
+    }
+};
+
+/**
+ * @class GridFile
+ * @brief A word-search grid loaded from a text file into one flat row-major buffer.
+ *
+ * The file holds one grid row per line, all of the same length; "\r\n" line ends
+ * and a missing final newline are accepted. The file is memory-mapped, the row
+ * boundaries are located with memchr and the rows are then copied into the flat
+ * buffer by several threads.
+ */
+class GridFile
+{
+private:
+    vector<char> cells; ///< Row-major grid without line ends
+    int rows;
+    int cols;
+
+public:
+    /**
+     * @brief Loads a grid file
+     * @param path File to load
+     * @param numThreads Threads used to copy rows (at least 1)
+     * @throw GridFileException if the file cannot be read, rows differ in length or are empty
+     */
+    explicit GridFile(const string& path, int numThreads = 1) : rows{0}, cols{0}
+    {
+        MappedFile file(path);
+        const char* data = file.data();
+        const char* end = data + file.size();
+
+        vector<const char*> rowStarts;
+        for (const char* line = data; line < end;)
+        {
+            const char* newline = static_cast<const char*>(memchr(line, '\n', end - line));
+            const char* lineEnd = newline ? newline : end;
+            size_t width = lineEnd - line;
+            if (width > 0 && line[width - 1] == '\r')
+                width--;
+
+            if (rowStarts.empty())
+                cols = width;
+            else if ((int)width != cols)
+                throw GridFileException();
+            rowStarts.push_back(line);
+            line = newline ? newline + 1 : end;
+        }
+        rows = rowStarts.size();
+        // Blank lines only: rows with no cells, which no grid view can describe
+        if (rows > 0 && cols == 0)
+            throw GridFileException();
+        cells.resize((size_t)rows * cols);
+
+        numThreads = max(1, min(numThreads, max(rows, 1)));
+        vector<thread> workers;
+        auto copyRows = [&](int t)
+        {
+            for (int i = t; i < rows; i += numThreads)
+                memcpy(cells.data() + (size_t)i * cols, rowStarts[i], cols);
+        };
+        for (int t = 1; t < numThreads; t++)
+            workers.emplace_back(copyRows, t);
+        copyRows(0);
+        for (thread& worker : workers)
+            worker.join();
+    }
+
+    /**
+     * @brief Gets a view of the loaded grid
+     */
+    GridView view() const
+    {
+        return {cells.data(), rows, cols};
+    }
+
+    int numRows() const
+    {
+        return rows;
+    }
+
+    int numCols() const
+    {
+        return cols;
+    }
+};
+
+#endif
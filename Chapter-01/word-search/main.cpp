@@ -0,0 +1,129 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <thread>
+#include "word-trie.h"
+#include "grid-file.h"
+#include "parallel-word-search.h"
+#include "word-dictionary.h"
+using namespace std;
+
+/**
+ * @brief Reads one word per line
+ */
+vector<string> readWords(const string& path)
+{
+    vector<string> words;
+    ifstream in(path);
+    for (string word; getline(in, word);)
+    {
+        if (!word.empty() && word.back() == '\r')
+            word.pop_back();
+        words.push_back(word);
+    }
+    return words;
+}
+
+/**
+ * @brief Main function demonstrating the trie and Aho–Corasick solvers
+ *
+ * Usage: ./main [grid-file word-file [threads]]
+ *        ./main --compile word-file dictionary-file
+ *        ./main --batch dictionary-file grid-file...
+ * With files, the grid is memory-mapped and searched on several threads and the
+ * number of matches is printed; without, a 4x4 sample grid is searched.
+ * --compile writes a binary dictionary, and --batch solves every grid against one
+ * loaded dictionary, printing each grid's number of matches.
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    if (argc == 4 && string(argv[1]) == "--compile")
+    {
+        try
+        {
+            writeDictionary(readWords(argv[2]), argv[3]);
+        }
+        catch (DictionaryFileException e)
+        {
+            cout << "Cannot write dictionary file!" << endl;
+            return 1;
+        }
+        catch (WordTooLongException e)
+        {
+            cout << "Word too long!" << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (argc > 2 && string(argv[1]) == "--batch")
+    {
+        try
+        {
+            WordDictionary dictionary(argv[2]);
+            vector<GridFile> grids;
+            vector<GridView> views;
+            for (int i = 3; i < argc; i++)
+                grids.emplace_back(argv[i]);
+            for (const GridFile& grid : grids)
+                views.push_back(grid.view());
+
+            vector<vector<WordMatch>> matches = findWordsBatch(views, dictionary, max(1u, thread::hardware_concurrency()));
+            for (size_t i = 0; i < matches.size(); i++)
+                cout << argv[i + 3] << ": " << matches[i].size() << " matches" << endl;
+        }
+        catch (DictionaryFileException e)
+        {
+            cout << "Cannot read dictionary file!" << endl;
+            return 1;
+        }
+        catch (GridFileException e)
+        {
+            cout << "Cannot read grid file!" << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (argc > 2)
+    {
+        int threads = argc > 3 ? stoi(argv[3]) : max(1u, thread::hardware_concurrency());
+        try
+        {
+            GridFile grid(argv[1], threads);
+            WordTrie trie(readWords(argv[2]));
+            AhoCorasick automaton(trie);
+            vector<WordMatch> matches = mergeMatches(findWordsParallel(grid.view(), automaton, threads));
+            cout << grid.numRows() << "x" << grid.numCols() << " grid, " << matches.size() << " matches" << endl;
+        }
+        catch (GridFileException e)
+        {
+            cout << "Cannot read grid file!" << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    const vector<vector<char>> grid = {
+        {'t', 'h', 'i', 's'},
+        {'w', 'a', 't', 's'},
+        {'o', 'a', 'h', 'g'},
+        {'f', 'g', 'd', 't'}
+    };
+    const vector<string> wordList = {"two", "fat", "that"};
+
+    vector<char> cells = flattenGrid(grid);
+    GridView view = {cells.data(), (int)grid.size(), (int)grid[0].size()};
+    WordTrie trie(wordList);
+    AhoCorasick automaton(trie);
+
+    for (const WordMatch& match : findWordsAhoCorasick(view, automaton))
+    {
+        cout << trie.word(match.word) << " at (" << match.row << ", " << match.column << ") direction ("
+             << DIRECTION_ROW[match.direction] << ", " << DIRECTION_COLUMN[match.direction] << ")" << endl;
+    }
+    return 0;
+}
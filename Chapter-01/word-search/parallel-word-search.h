@@ -0,0 +1,77 @@
+#ifndef PARALLEL_WORD_SEARCH_H
+#define PARALLEL_WORD_SEARCH_H
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include "word-trie.h"
+using namespace std;
+
+/**
+ * @brief Matches collected by one worker, aligned so neighbouring workers do not share a cache line
+ */
+struct alignas(64) WorkerMatches
+{
+    vector<WordMatch> matches;
+};
+
+/**
+ * @brief Finds every dictionary word by scanning the grid lines on several threads
+ *
+ * The rows, columns and diagonals in all 8 directions are independent scan lines.
+ * Workers claim batches of lines from a shared counter and run the Aho–Corasick
+ * automaton over them, appending matches to their own buffer only.
+ *
+ * @param grid Grid view
+ * @param automaton Compiled dictionary automaton
+ * @param numThreads Number of threads (at least 1)
+ * @param linesPerBatch Lines claimed per counter increment
+ * @return One match buffer per worker; together they hold every match exactly once
+ */
+inline vector<WorkerMatches> findWordsParallel(const GridView& grid, const AhoCorasick& automaton,
+                                               int numThreads, int linesPerBatch = 64)
+{
+    numThreads = max(numThreads, 1);
+    const vector<ScanLine> lines = scanLines(grid.rows, grid.cols);
+    const size_t batches = (lines.size() + linesPerBatch - 1) / linesPerBatch;
+
+    vector<WorkerMatches> results(numThreads);
+    atomic<size_t> nextBatch{0};
+    auto worker = [&](int t)
+    {
+        vector<WordMatch>& found = results[t].matches;
+        auto collect = [&found](const WordMatch& match) { found.push_back(match); };
+        for (size_t batch = nextBatch++; batch < batches; batch = nextBatch++)
+        {
+            size_t end = min(lines.size(), (batch + 1) * linesPerBatch);
+            for (size_t i = batch * linesPerBatch; i < end; i++)
+                automaton.scan(grid, lines[i], collect);
+        }
+    };
+
+    vector<thread> workers;
+    for (int t = 1; t < numThreads; t++)
+        workers.emplace_back(worker, t);
+    worker(0);
+    for (thread& w : workers)
+        w.join();
+    return results;
+}
+
+/**
+ * @brief Concatenates per-worker match buffers
+ */
+inline vector<WordMatch> mergeMatches(const vector<WorkerMatches>& perWorker)
+{
+    size_t total = 0;
+    for (const WorkerMatches& worker : perWorker)
+        total += worker.matches.size();
+
+    vector<WordMatch> merged;
+    merged.reserve(total);
+    for (const WorkerMatches& worker : perWorker)
+        merged.insert(merged.end(), worker.matches.begin(), worker.matches.end());
+    return merged;
+}
+
+#endif
@@ -0,0 +1,475 @@
+#ifndef WORD_DICTIONARY_H
+#define WORD_DICTIONARY_H
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include "word-trie.h"
+#include "grid-file.h"
+using namespace std;
+
+/**
+ * @brief Exception thrown when a dictionary file cannot be read or written, or fails validation
+ */
+class DictionaryFileException {};
+
+/**
+ * @brief Exception thrown when compiling a word longer than the format allows
+ */
+class WordTooLongException {};
+
+/**
+ * @brief Longest word a compiled dictionary can hold, in bytes
+ */
+const size_t DICTIONARY_MAX_WORD = 255;
+
+/**
+ * @brief Fixed-size header at the start of a compiled dictionary
+ *
+ * The header is followed by a first-byte index, then by blockCount 32-bit offsets
+ * into the entry data and then by the entries. Index entry c counts the blocks whose
+ * first word sorts before the one-byte string c, so a lookup only binary-searches
+ * the blocks of its key's first byte. Every entry is one byte of prefix length
+ * shared with the previous word, one byte of suffix length and the suffix bytes.
+ * The first word of each block shares nothing, so it is stored whole and can be
+ * compared in place.
+ * Integers are in host byte order.
+ */
+struct DictionaryHeader
+{
+    char magic[8];      ///< "WORDDICT"
+    uint32_t version;   ///< Format version, currently 1
+    uint32_t wordCount; ///< Number of distinct words
+    uint32_t blockSize; ///< Words per block
+    uint32_t blockCount;
+    uint32_t maxLength; ///< Longest word in bytes
+    uint32_t reserved;
+    uint64_t dataSize;  ///< Bytes of entry data
+    uint64_t checksum;  ///< FNV-1a hash of everything after the header
+};
+
+/**
+ * @brief Number of entries in the first-byte index
+ */
+const size_t DICTIONARY_BYTE_INDEX = 257;
+
+/**
+ * @brief 64-bit FNV-1a hash
+ */
+inline uint64_t fnv1a(const char* bytes, size_t length, uint64_t hash = 14695981039346656037ull)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (unsigned char)bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Compiles a word list into the binary dictionary format
+ * @param words Word list; it is sorted, duplicates and empty strings are dropped
+ * @param blockSize Words per block; larger blocks compress better but lookups scan further
+ * @return The file contents
+ * @throw WordTooLongException if a word is longer than DICTIONARY_MAX_WORD bytes
+ */
+inline vector<char> compileDictionary(vector<string> words, uint32_t blockSize = 16)
+{
+    blockSize = max<uint32_t>(blockSize, 1);
+    sort(words.begin(), words.end());
+    words.erase(unique(words.begin(), words.end()), words.end());
+    words.erase(remove(words.begin(), words.end(), string()), words.end());
+
+    DictionaryHeader header = {};
+    memcpy(header.magic, "WORDDICT", 8);
+    header.version = 1;
+    header.wordCount = words.size();
+    header.blockSize = blockSize;
+    header.blockCount = (words.size() + blockSize - 1) / blockSize;
+
+    vector<uint32_t> offsets;
+    vector<char> entries;
+    for (size_t i = 0; i < words.size(); i++)
+    {
+        const string& word = words[i];
+        if (word.size() > DICTIONARY_MAX_WORD)
+            throw WordTooLongException();
+        header.maxLength = max<uint32_t>(header.maxLength, word.size());
+
+        size_t shared = 0;
+        if (i % blockSize == 0)
+            offsets.push_back(entries.size());
+        else
+            while (shared < word.size() && shared < words[i - 1].size() && word[shared] == words[i - 1][shared])
+                shared++;
+        entries.push_back((char)shared);
+        entries.push_back((char)(word.size() - shared));
+        entries.insert(entries.end(), word.begin() + shared, word.end());
+    }
+    header.dataSize = entries.size();
+
+    vector<uint32_t> byteIndex(DICTIONARY_BYTE_INDEX);
+    for (size_t c = 0, block = 0; c < DICTIONARY_BYTE_INDEX; c++)
+    {
+        while (block < header.blockCount && (unsigned char)words[block * blockSize][0] < c)
+            block++;
+        byteIndex[c] = block;
+    }
+
+    vector<char> file(sizeof(DictionaryHeader) + (DICTIONARY_BYTE_INDEX + offsets.size()) * sizeof(uint32_t) + entries.size());
+    char* body = file.data() + sizeof(DictionaryHeader);
+    memcpy(body, byteIndex.data(), DICTIONARY_BYTE_INDEX * sizeof(uint32_t));
+    if (!offsets.empty())
+        memcpy(body + DICTIONARY_BYTE_INDEX * sizeof(uint32_t), offsets.data(), offsets.size() * sizeof(uint32_t));
+    if (!entries.empty())
+        memcpy(body + (DICTIONARY_BYTE_INDEX + offsets.size()) * sizeof(uint32_t), entries.data(), entries.size());
+    header.checksum = fnv1a(body, file.size() - sizeof(DictionaryHeader));
+    memcpy(file.data(), &header, sizeof(DictionaryHeader));
+    return file;
+}
+
+/**
+ * @brief Compiles a word list and writes it to a file
+ * @throw DictionaryFileException if the file cannot be written
+ * @throw WordTooLongException if a word is longer than DICTIONARY_MAX_WORD bytes
+ */
+inline void writeDictionary(const vector<string>& words, const string& path, uint32_t blockSize = 16)
+{
+    vector<char> bytes = compileDictionary(words, blockSize);
+    ofstream out(path, ios::binary);
+    if (!out.write(bytes.data(), bytes.size()))
+        throw DictionaryFileException();
+}
+
+/**
+ * @brief Result of looking up a key in a WordDictionary
+ */
+struct DictionaryLookup
+{
+    int index;      ///< Sorted index of the first word not less than the key, wordCount() if none
+    uint32_t block; ///< Block holding that word; later lookups of longer keys can start here
+    bool exact;     ///< The key is a word
+    bool prefix;    ///< Some word starts with the key
+};
+
+/**
+ * @class WordDictionary
+ * @brief Read-only view of a compiled, prefix-compressed dictionary.
+ *
+ * The dictionary is queried where it lies, in a memory-mapped file or a caller's
+ * buffer, without building any per-process structure, so loading costs one mapping
+ * and (optionally) one checksum pass. Word ids are positions in sorted order.
+ */
+class WordDictionary
+{
+private:
+    unique_ptr<MappedFile> file; ///< Mapping, when loaded from a path
+    vector<char> owned;          ///< Contents, when constructed from a buffer
+    DictionaryHeader header;
+    const char* byteIndex;       ///< DICTIONARY_BYTE_INDEX unaligned 32-bit block counts
+    const char* offsets;         ///< blockCount unaligned 32-bit offsets
+    const char* data;            ///< Entry data
+
+    /**
+     * @brief Checks the header and locates the offset table and entries
+     */
+    void attach(const char* bytes, size_t length, bool verify)
+    {
+        if (length < sizeof(DictionaryHeader))
+            throw DictionaryFileException();
+        memcpy(&header, bytes, sizeof(DictionaryHeader));
+        if (memcmp(header.magic, "WORDDICT", 8) != 0 || header.version != 1 || header.blockSize == 0
+            || header.blockCount != (header.wordCount + (uint64_t)header.blockSize - 1) / header.blockSize
+            || length != sizeof(DictionaryHeader) + (DICTIONARY_BYTE_INDEX + (uint64_t)header.blockCount) * sizeof(uint32_t)
+                         + header.dataSize)
+            throw DictionaryFileException();
+        byteIndex = bytes + sizeof(DictionaryHeader);
+        offsets = byteIndex + DICTIONARY_BYTE_INDEX * sizeof(uint32_t);
+        data = offsets + (size_t)header.blockCount * sizeof(uint32_t);
+        if (verify && fnv1a(byteIndex, length - sizeof(DictionaryHeader)) != header.checksum)
+            throw DictionaryFileException();
+    }
+
+    /**
+     * @brief Reads the i-th unaligned 32-bit value of a table
+     */
+    static uint32_t load(const char* table, size_t i)
+    {
+        uint32_t value;
+        memcpy(&value, table + i * sizeof(uint32_t), sizeof(uint32_t));
+        return value;
+    }
+
+    /**
+     * @brief Byte offset of a block's first entry
+     */
+    uint32_t blockOffset(uint32_t block) const
+    {
+        return load(offsets, block);
+    }
+
+    /**
+     * @brief First word of a block, in place
+     */
+    string_view blockFirst(uint32_t block) const
+    {
+        const char* entry = data + blockOffset(block);
+        return string_view(entry + 2, (unsigned char)entry[1]);
+    }
+
+public:
+    /**
+     * @brief Maps a compiled dictionary file
+     * @param path File written by writeDictionary
+     * @param verify Whether to check the checksum, which reads the whole file once
+     * @throw DictionaryFileException if the file cannot be read or is not a valid dictionary
+     */
+    explicit WordDictionary(const string& path, bool verify = true)
+    {
+        try
+        {
+            file.reset(new MappedFile(path));
+        }
+        catch (GridFileException e)
+        {
+            throw DictionaryFileException();
+        }
+        attach(file->data(), file->size(), verify);
+    }
+
+    /**
+     * @brief Takes ownership of compiled dictionary bytes, e.g. from compileDictionary
+     * @throw DictionaryFileException if the bytes are not a valid dictionary
+     */
+    explicit WordDictionary(vector<char> bytes, bool verify = true) : owned{std::move(bytes)}
+    {
+        attach(owned.data(), owned.size(), verify);
+    }
+
+    int size() const
+    {
+        return header.wordCount;
+    }
+
+    /**
+     * @brief Length of the longest word in bytes
+     */
+    int maxLength() const
+    {
+        return header.maxLength;
+    }
+
+    /**
+     * @brief Decodes the words of one block in order
+     * @param block Block index
+     * @param visit Called as visit(int index, string_view word); decoding stops when it returns false
+     */
+    template <typename Visitor>
+    void forEachInBlock(uint32_t block, Visitor&& visit) const
+    {
+        char word[DICTIONARY_MAX_WORD];
+        const char* entry = data + blockOffset(block);
+        uint32_t first = block * header.blockSize;
+        uint32_t last = min(header.wordCount, first + header.blockSize);
+        for (uint32_t index = first; index < last; index++)
+        {
+            size_t shared = (unsigned char)entry[0], suffix = (unsigned char)entry[1];
+            memcpy(word + shared, entry + 2, suffix);
+            entry += 2 + suffix;
+            if (!visit((int)index, string_view(word, shared + suffix)))
+                return;
+        }
+    }
+
+    /**
+     * @brief Finds the first word not less than key
+     * @param key Key to look up
+     * @param fromBlock Block to start the search at; any block at or before the key's position is valid
+     * @note Complexity: O(log blocks + blockSize)
+     */
+    DictionaryLookup lookup(string_view key, uint32_t fromBlock = 0) const
+    {
+        // Last block whose first word is <= key, among the blocks the key's first byte allows
+        uint32_t low = fromBlock, high = header.blockCount;
+        if (!key.empty())
+        {
+            unsigned char c = key[0];
+            low = max(low, max<uint32_t>(load(byteIndex, c), 1) - 1);
+            high = max(low + 1, load(byteIndex, c + 1));
+        }
+        while (high - low > 1)
+        {
+            uint32_t middle = low + (high - low) / 2;
+            if (blockFirst(middle) <= key)
+                low = middle;
+            else
+                high = middle;
+        }
+
+        DictionaryLookup result = {(int)header.wordCount, low, false, false};
+        if (low >= header.blockCount)
+            return result;
+
+        // Scan the block without decoding it: 'matched' is how many leading bytes the
+        // previous word, which sorts before the key, has in common with the key
+        const char* entry = data + blockOffset(low);
+        const uint32_t first = low * header.blockSize, last = min(header.wordCount, first + header.blockSize);
+        size_t matched = 0;
+        bool found = false;
+        for (uint32_t index = first; index < last && !found; index++)
+        {
+            const size_t shared = (unsigned char)entry[0], length = shared + (unsigned char)entry[1];
+            const char* suffix = entry + 2 - shared;
+            entry += 2 + length - shared;
+            if (shared > matched)
+                continue; // Agrees with the previous word where that one sorted below the key
+            if (shared < matched)
+                found = true; // Leaves the key's prefix upwards
+            else
+            {
+                size_t i = matched;
+                while (i < length && i < key.size() && suffix[i] == key[i])
+                    i++;
+                if (i == key.size())
+                {
+                    found = true;
+                    result.exact = length == key.size();
+                    result.prefix = true;
+                }
+                else if (i < length && (unsigned char)suffix[i] > (unsigned char)key[i])
+                    found = true;
+                matched = i;
+            }
+            if (found)
+                result.index = index;
+        }
+        if (!found && low + 1 < header.blockCount)
+        {
+            string_view next = blockFirst(low + 1);
+            result.index = (low + 1) * header.blockSize;
+            result.block = low + 1;
+            result.exact = next == key;
+            result.prefix = next.substr(0, key.size()) == key;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Sorted index of a word, -1 if absent
+     */
+    int find(string_view word) const
+    {
+        DictionaryLookup result = lookup(word);
+        return result.exact ? result.index : -1;
+    }
+
+    bool contains(string_view word) const
+    {
+        return lookup(word).exact;
+    }
+
+    /**
+     * @brief Checks whether some word starts with prefix
+     */
+    bool hasPrefix(string_view prefix) const
+    {
+        return lookup(prefix).prefix;
+    }
+
+    /**
+     * @brief Decodes the word with a given sorted index
+     */
+    string word(int index) const
+    {
+        string result;
+        forEachInBlock(index / header.blockSize, [&](int i, string_view word)
+        {
+            if (i < index)
+                return true;
+            result.assign(word);
+            return false;
+        });
+        return result;
+    }
+};
+
+/**
+ * @brief Finds every dictionary word starting at every cell in every direction, using a compiled dictionary
+ *
+ * Each walk extends its prefix one letter at a time and stops once no word has that
+ * prefix; since longer prefixes sort after shorter ones, each lookup resumes at the
+ * block the previous one ended in.
+ *
+ * @param grid Grid view
+ * @param dictionary Compiled dictionary; WordMatch::word is the sorted word index
+ * @return Matches in cell-major, then direction, then length order
+ */
+inline vector<WordMatch> findWordsDictionary(const GridView& grid, const WordDictionary& dictionary)
+{
+    vector<WordMatch> matches;
+    string prefix;
+    prefix.reserve(dictionary.maxLength());
+    for (int i = 0; i < grid.rows; i++)
+    {
+        for (int j = 0; j < grid.cols; j++)
+        {
+            for (int d = 0; d < WORD_DIRECTIONS; d++)
+            {
+                prefix.clear();
+                uint32_t block = 0;
+                for (int row = i, column = j; grid.contains(row, column) && (int)prefix.size() < dictionary.maxLength();
+                     row += DIRECTION_ROW[d], column += DIRECTION_COLUMN[d])
+                {
+                    prefix.push_back(grid.at(row, column));
+                    DictionaryLookup result = dictionary.lookup(prefix, block);
+                    if (!result.prefix)
+                        break;
+                    block = result.block;
+                    if (result.exact)
+                        matches.push_back({result.index, i, j, d});
+                }
+            }
+        }
+    }
+    return matches;
+}
+
+/**
+ * @brief Solves many puzzles against one loaded dictionary
+ *
+ * Workers claim grids from a shared counter, so a batch of small puzzles pays the
+ * dictionary setup once instead of once per puzzle.
+ *
+ * @param grids Grid views
+ * @param dictionary Compiled dictionary
+ * @param numThreads Number of threads (at least 1)
+ * @return The matches of each grid, in the order of grids
+ */
+inline vector<vector<WordMatch>> findWordsBatch(const vector<GridView>& grids, const WordDictionary& dictionary,
+                                                int numThreads = 1)
+{
+    numThreads = max(numThreads, 1);
+    vector<vector<WordMatch>> results(grids.size());
+    atomic<size_t> nextGrid{0};
+    auto worker = [&]()
+    {
+        for (size_t g = nextGrid++; g < grids.size(); g = nextGrid++)
+            results[g] = findWordsDictionary(grids[g], dictionary);
+    };
+
+    vector<thread> workers;
+    for (int t = 1; t < numThreads; t++)
+        workers.emplace_back(worker);
+    worker();
+    for (thread& w : workers)
+        w.join();
+    return results;
+}
+
+#endif
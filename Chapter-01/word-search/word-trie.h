@@ -0,0 +1,362 @@
+#ifndef WORD_TRIE_H
+#define WORD_TRIE_H
+#include <vector>
+#include <string>
+#include <queue>
+#include <algorithm>
+using namespace std;
+
+/**
+ * @brief Number of search directions
+ */
+const int WORD_DIRECTIONS = 8;
+
+/**
+ * @brief Row step of each direction, in the same order as puzzleWords uses
+ *
+ * 0: down-right, 1: up-left, 2: up-right, 3: down-left, 4: up, 5: down, 6: left, 7: right
+ */
+const int DIRECTION_ROW[WORD_DIRECTIONS] = {1, -1, -1, 1, -1, 1, 0, 0};
+
+/**
+ * @brief Column step of each direction, in the same order as puzzleWords uses
+ */
+const int DIRECTION_COLUMN[WORD_DIRECTIONS] = {1, -1, 1, -1, 0, 0, -1, 1};
+
+/**
+ * @brief A dictionary word found in the grid
+ */
+struct WordMatch
+{
+    int word;      ///< Index of the word in the dictionary
+    int row;       ///< Row of the first letter
+    int column;    ///< Column of the first letter
+    int direction; ///< Index into DIRECTION_ROW / DIRECTION_COLUMN
+};
+
+/**
+ * @brief Read-only view of a row-major character grid
+ */
+struct GridView
+{
+    const char* cells;
+    int rows;
+    int cols;
+
+    char at(int row, int column) const
+    {
+        return cells[(size_t)row * cols + column];
+    }
+
+    bool contains(int row, int column) const
+    {
+        return row >= 0 && row < rows && column >= 0 && column < cols;
+    }
+};
+
+/**
+ * @brief Copies a vector-of-rows grid into one contiguous row-major buffer
+ */
+inline vector<char> flattenGrid(const vector<vector<char>>& grid)
+{
+    vector<char> cells;
+    cells.reserve(grid.size() * (grid.empty() ? 0 : grid[0].size()));
+    for (const vector<char>& row : grid)
+        cells.insert(cells.end(), row.begin(), row.end());
+    return cells;
+}
+
+/**
+ * @brief The start of a straight scan line: its first cell and direction
+ */
+struct ScanLine
+{
+    int row;
+    int column;
+    int direction;
+};
+
+/**
+ * @brief Lists every maximal straight line of the grid, once per direction
+ *
+ * A line starts at each cell whose predecessor in that direction is off the grid,
+ * so every (cell, direction) pair lies on exactly one line. Those cells are the
+ * border row the direction leaves from plus the border column it leaves from, so
+ * the lines are built in O(rows + cols) without visiting the interior.
+ */
+inline vector<ScanLine> scanLines(int rows, int cols)
+{
+    vector<ScanLine> lines;
+    if (rows <= 0 || cols <= 0)
+        return lines;
+    for (int d = 0; d < WORD_DIRECTIONS; d++)
+    {
+        const int dr = DIRECTION_ROW[d], dc = DIRECTION_COLUMN[d];
+        const int startRow = dr > 0 ? 0 : rows - 1, startColumn = dc > 0 ? 0 : cols - 1;
+        if (dr != 0)
+            for (int j = 0; j < cols; j++)
+                lines.push_back({startRow, j, d});
+        if (dc != 0)
+            for (int i = 0; i < rows; i++)
+                if (dr == 0 || i != startRow)
+                    lines.push_back({i, startColumn, d});
+    }
+    return lines;
+}
+
+/**
+ * @class WordTrie
+ * @brief Dictionary trie stored as one flat array of nodes.
+ *
+ * Characters are remapped to a dense alphabet of the symbols that occur in the
+ * dictionary, and node n's children occupy children[n * alphabetSize(), ...).
+ * A character outside the dictionary alphabet has no child anywhere, so walks stop
+ * as soon as the prefix can no longer match.
+ */
+class WordTrie
+{
+private:
+    vector<string> words;   ///< Distinct dictionary words, indexed by word id
+    int symbols[256];       ///< Dense symbol of each byte, -1 if unused
+    int alphabet;           ///< Number of distinct symbols
+    vector<int> children;   ///< nodeCount() * alphabet child indices, -1 for none
+    vector<int> terminal;   ///< Word id ending at each node, -1 for none
+
+public:
+    /**
+     * @brief Builds the trie
+     * @param wordList Dictionary; duplicates and empty strings are ignored
+     * @note Complexity: O(total length * alphabet)
+     */
+    explicit WordTrie(const vector<string>& wordList) : alphabet{0}
+    {
+        fill(symbols, symbols + 256, -1);
+        for (const string& word : wordList)
+            for (unsigned char c : word)
+                if (symbols[c] < 0)
+                    symbols[c] = alphabet++;
+
+        children.assign(alphabet, -1);
+        terminal.assign(1, -1);
+        for (const string& word : wordList)
+        {
+            if (word.empty())
+                continue;
+            int node = 0;
+            for (unsigned char c : word)
+            {
+                int& next = children[(size_t)node * alphabet + symbols[c]];
+                if (next < 0)
+                {
+                    next = terminal.size();
+                    terminal.push_back(-1);
+                    children.resize(children.size() + alphabet, -1);
+                }
+                node = children[(size_t)node * alphabet + symbols[c]];
+            }
+            if (terminal[node] < 0)
+            {
+                terminal[node] = words.size();
+                words.push_back(word);
+            }
+        }
+    }
+
+    /**
+     * @brief Dense symbol of a character, -1 if it occurs in no word
+     */
+    int symbolOf(char c) const
+    {
+        return symbols[(unsigned char)c];
+    }
+
+    int alphabetSize() const
+    {
+        return alphabet;
+    }
+
+    int nodeCount() const
+    {
+        return terminal.size();
+    }
+
+    /**
+     * @brief Follows the edge labelled c
+     * @return The child node, or -1 if no dictionary word continues with c
+     */
+    int child(int node, char c) const
+    {
+        int symbol = symbolOf(c);
+        return symbol < 0 ? -1 : children[(size_t)node * alphabet + symbol];
+    }
+
+    /**
+     * @brief Child by dense symbol, for callers that already remapped the character
+     */
+    int childBySymbol(int node, int symbol) const
+    {
+        return children[(size_t)node * alphabet + symbol];
+    }
+
+    /**
+     * @brief Word id ending at node, -1 if none
+     */
+    int wordAt(int node) const
+    {
+        return terminal[node];
+    }
+
+    const string& word(int id) const
+    {
+        return words[id];
+    }
+
+    int wordCount() const
+    {
+        return words.size();
+    }
+};
+
+/**
+ * @brief Finds every dictionary word starting at every cell in every direction by walking the trie
+ *
+ * Each walk stops at the first prefix that no dictionary word has, so the cost per
+ * start is bounded by the longest matching prefix rather than the grid side.
+ *
+ * @param grid Grid view
+ * @param trie Compiled dictionary
+ * @return Matches in cell-major, then direction, then length order
+ */
+inline vector<WordMatch> findWordsTrie(const GridView& grid, const WordTrie& trie)
+{
+    vector<WordMatch> matches;
+    for (int i = 0; i < grid.rows; i++)
+    {
+        for (int j = 0; j < grid.cols; j++)
+        {
+            for (int d = 0; d < WORD_DIRECTIONS; d++)
+            {
+                int node = 0;
+                for (int row = i, column = j; grid.contains(row, column); row += DIRECTION_ROW[d], column += DIRECTION_COLUMN[d])
+                {
+                    node = trie.child(node, grid.at(row, column));
+                    if (node < 0)
+                        break;
+                    if (trie.wordAt(node) >= 0)
+                        matches.push_back({trie.wordAt(node), i, j, d});
+                }
+            }
+        }
+    }
+    return matches;
+}
+
+/**
+ * @class AhoCorasick
+ * @brief Aho–Corasick automaton over a WordTrie for one-pass scanning of grid lines.
+ *
+ * The trie's child table is completed into a full transition table (missing edges
+ * follow failure links), and each node gets a link to the nearest proper suffix that
+ * is a word. The trie must outlive the automaton.
+ */
+class AhoCorasick
+{
+private:
+    const WordTrie& trie;
+    vector<int> transitions; ///< nodeCount() * alphabet complete transition table
+    vector<int> outputLink;  ///< Nearest proper suffix node that ends a word, -1 if none
+
+public:
+    /**
+     * @brief Builds the automaton with a breadth-first pass over the trie
+     * @param trie Compiled dictionary
+     * @note Complexity: O(nodes * alphabet)
+     */
+    explicit AhoCorasick(const WordTrie& trie) : trie(trie)
+    {
+        const int alphabet = trie.alphabetSize();
+        const int nodes = trie.nodeCount();
+        transitions.assign((size_t)nodes * alphabet, 0);
+        outputLink.assign(nodes, -1);
+        vector<int> failure(nodes, 0);
+
+        queue<int> pending;
+        for (int s = 0; s < alphabet; s++)
+        {
+            int next = trie.childBySymbol(0, s);
+            if (next >= 0)
+            {
+                transitions[s] = next;
+                pending.push(next);
+            }
+        }
+
+        while (!pending.empty())
+        {
+            int node = pending.front();
+            pending.pop();
+            int fail = failure[node];
+            outputLink[node] = trie.wordAt(fail) >= 0 ? fail : outputLink[fail];
+            for (int s = 0; s < alphabet; s++)
+            {
+                int next = trie.childBySymbol(node, s);
+                int fallback = transitions[(size_t)fail * alphabet + s];
+                if (next >= 0)
+                {
+                    transitions[(size_t)node * alphabet + s] = next;
+                    failure[next] = fallback;
+                    pending.push(next);
+                }
+                else
+                    transitions[(size_t)node * alphabet + s] = fallback;
+            }
+        }
+    }
+
+    const WordTrie& dictionary() const
+    {
+        return trie;
+    }
+
+    /**
+     * @brief Runs the automaton along one grid line and reports every word on it
+     * @param grid Grid view
+     * @param line Start cell and direction of the line
+     * @param onMatch Called as onMatch(const WordMatch&) with the match's first cell
+     */
+    template <typename Sink>
+    void scan(const GridView& grid, const ScanLine& line, Sink&& onMatch) const
+    {
+        const int alphabet = trie.alphabetSize();
+        const int dr = DIRECTION_ROW[line.direction], dc = DIRECTION_COLUMN[line.direction];
+        int node = 0;
+        for (int row = line.row, column = line.column; grid.contains(row, column); row += dr, column += dc)
+        {
+            int symbol = trie.symbolOf(grid.at(row, column));
+            node = symbol < 0 ? 0 : transitions[(size_t)node * alphabet + symbol];
+            for (int m = trie.wordAt(node) >= 0 ? node : outputLink[node]; m >= 0; m = outputLink[m])
+            {
+                int word = trie.wordAt(m);
+                int back = trie.word(word).size() - 1;
+                onMatch(WordMatch{word, row - back * dr, column - back * dc, line.direction});
+            }
+        }
+    }
+};
+
+/**
+ * @brief Finds every dictionary word by scanning each grid line once per direction
+ * @param grid Grid view
+ * @param automaton Compiled dictionary automaton
+ * @return All matches, grouped by scan line
+ * @note Complexity: O(8 * cells + matches)
+ */
+inline vector<WordMatch> findWordsAhoCorasick(const GridView& grid, const AhoCorasick& automaton)
+{
+    vector<WordMatch> matches;
+    for (const ScanLine& line : scanLines(grid.rows, grid.cols))
+        automaton.scan(grid, line, [&](const WordMatch& match) { matches.push_back(match); });
+    return matches;
+}
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
+/**
+ * @brief Append-only vector that many threads can push_back into at once
+ *
+ * Elements live in segments of 16, 32, 64, ... slots that are never reallocated,
+ * so appends never move existing elements and references stay valid for the
+ * lifetime of the vector. push_back claims a slot with one atomic increment;
+ * the thread that first needs a segment allocates it and publishes it with a
+ * compare-and-swap, and a thread that loses the race frees its copy. operator[]
+ * finds the segment from the index with a bit scan.
+ *
+ * size() counts claimed slots, so while appends are running a reader should only
+ * touch elements whose push_back it has seen return (or that another thread
+ * handed over after its push_back returned).
+ *
+ * A claimed slot cannot be given back, so an element is only constructed in its
+ * slot once nothing can throw: Object must be nothrow move constructible, and
+ * an element whose constructor may throw is built first and then moved in. For
+ * the same reason, running out of memory for a new segment during an append
+ * terminates the program; reserve() allocates the segments ahead of time and
+ * reports bad_alloc as an exception instead.
+ */
+template <typename Object>
+class ConcurrentVector
+{
+public:
+    static const int FIRST_SEGMENT_BITS = 4;            ///< log2 of the first segment's size
+    static const int SEGMENTS = 64 - FIRST_SEGMENT_BITS; ///< Enough segments for any size_t index
+
+    ConcurrentVector()
+    {
+        for (std::atomic<Object *> &segment : segments)
+            segment.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ConcurrentVector(const ConcurrentVector &rhs) = delete;
+    ConcurrentVector &operator=(const ConcurrentVector &rhs) = delete;
+
+    ~ConcurrentVector()
+    {
+        size_t count = size();
+        for (size_t i = 0; i < count; i++)
+            (*this)[i].~Object();
+        for (int k = 0; k < SEGMENTS; k++)
+            if (Object *segment = segments[k].load(std::memory_order_relaxed))
+                std::allocator<Object>().deallocate(segment, segmentSize(k));
+    }
+
+    /**
+     * @brief Appends a copy of x; safe to call from any number of threads
+     * @return Reference to the new element, valid until the vector is destroyed
+     */
+    Object &push_back(const Object &x)
+    {
+        return emplace_back(x);
+    }
+
+    Object &push_back(Object &&x)
+    {
+        return emplace_back(std::move(x));
+    }
+
+    /**
+     * @brief Constructs an element at the end; safe to call from any number of threads
+     *
+     * If the constructor may throw, the element is built before a slot is claimed,
+     * so an exception leaves the vector unchanged.
+     */
+    template <typename... Args>
+    Object &emplace_back(Args &&...args)
+    {
+        static_assert(std::is_nothrow_move_constructible<Object>::value,
+                      "ConcurrentVector elements must be nothrow move constructible");
+        if constexpr (std::is_nothrow_constructible<Object, Args &&...>::value)
+            return constructAtEnd(std::forward<Args>(args)...);
+        else
+        {
+            Object x(std::forward<Args>(args)...);
+            return constructAtEnd(std::move(x));
+        }
+    }
+
+    /**
+     * @brief Allocates the segments needed for newCapacity elements ahead of time
+     */
+    void reserve(size_t newCapacity)
+    {
+        if (newCapacity == 0)
+            return;
+        for (int k = 0; k <= segmentOf(newCapacity - 1); k++)
+            segmentFor(k);
+    }
+
+    Object &operator[](size_t index)
+    {
+        int k = segmentOf(index);
+        return segments[k].load(std::memory_order_acquire)[index + FIRST_SIZE - segmentSize(k)];
+    }
+
+    const Object &operator[](size_t index) const
+    {
+        int k = segmentOf(index);
+        return segments[k].load(std::memory_order_acquire)[index + FIRST_SIZE - segmentSize(k)];
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    size_t size() const
+    {
+        return theSize.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Slots in the segments allocated so far
+     */
+    size_t capacity() const
+    {
+        size_t total = 0;
+        for (int k = 0; k < SEGMENTS; k++)
+            if (segments[k].load(std::memory_order_acquire) != nullptr)
+                total += segmentSize(k);
+        return total;
+    }
+
+    const Object &back() const
+    {
+        return (*this)[size() - 1];
+    }
+
+    /**
+     * @brief Forward iterator over indices; stable across concurrent appends
+     */
+    template <typename Container, typename Value>
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename std::remove_const<Value>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value *pointer;
+        typedef Value &reference;
+
+        Iterator() : vector{nullptr}, index{0}
+        {}
+
+        Iterator(Container *vector, size_t index) : vector{vector}, index{index}
+        {}
+
+        Value &operator*() const
+        {
+            return (*vector)[index];
+        }
+
+        Value *operator->() const
+        {
+            return &(*vector)[index];
+        }
+
+        Iterator &operator++()
+        {
+            index++;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const Iterator &rhs) const
+        {
+            return index == rhs.index;
+        }
+
+        bool operator!=(const Iterator &rhs) const
+        {
+            return index != rhs.index;
+        }
+
+    private:
+        Container *vector;
+        size_t index;
+    };
+
+    typedef Iterator<ConcurrentVector, Object> iterator;
+    typedef Iterator<const ConcurrentVector, const Object> const_iterator;
+
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    iterator end()
+    {
+        return iterator(this, size());
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, size());
+    }
+
+private:
+    static const size_t FIRST_SIZE = size_t(1) << FIRST_SEGMENT_BITS;
+
+    alignas(64) std::atomic<size_t> theSize{0};           ///< Claimed slots; alone on its line, as every append hits it
+    alignas(64) std::atomic<Object *> segments[SEGMENTS]; ///< Segment k holds FIRST_SIZE << k slots
+
+    static size_t segmentSize(int k)
+    {
+        return FIRST_SIZE << k;
+    }
+
+    /**
+     * @brief Segment holding index: slots [FIRST_SIZE * (2^k - 1), FIRST_SIZE * (2^(k+1) - 1)) are in segment k
+     */
+    static int segmentOf(size_t index)
+    {
+        return 63 - __builtin_clzll(index + FIRST_SIZE) - FIRST_SEGMENT_BITS;
+    }
+
+    /**
+     * @brief Claims the next index and constructs the element there
+     *
+     * noexcept because a claimed slot must end up constructed: if its segment cannot
+     * be allocated, the program terminates rather than leave a hole that size() counts.
+     */
+    template <typename... Args>
+    Object &constructAtEnd(Args &&...args) noexcept
+    {
+        return *new (claimSlot()) Object(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Claims the next index and returns its raw slot, allocating the segment if needed
+     */
+    Object *claimSlot()
+    {
+        size_t index = theSize.fetch_add(1, std::memory_order_relaxed);
+        int k = segmentOf(index);
+        return segmentFor(k) + (index + FIRST_SIZE - segmentSize(k));
+    }
+
+    /**
+     * @brief Returns segment k, allocating and publishing it if no thread has yet
+     */
+    Object *segmentFor(int k)
+    {
+        Object *segment = segments[k].load(std::memory_order_acquire);
+        if (segment != nullptr)
+            return segment;
+        Object *fresh = std::allocator<Object>().allocate(segmentSize(k));
+        if (segments[k].compare_exchange_strong(segment, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+            return fresh;
+        std::allocator<Object>().deallocate(fresh, segmentSize(k));
+        return segment;
+    }
+};
+#endif
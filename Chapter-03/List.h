@@ -0,0 +1,971 @@
+#ifndef LIST_H
+#define LIST_H
+#include <memory>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * @brief Exception thrown when reading or removing from an empty list
+ */
+class EmptyListException {};
+
+/**
+ * @brief Free-list pool that hands out nodes from large slabs instead of one allocation per node
+ *
+ * Slabs double from 64 up to 4096 nodes. A new slab is threaded onto the free list
+ * in address order, so nodes allocated one after another sit next to each other
+ * in memory. The pool only provides storage; callers construct and destroy the
+ * nodes. Not thread-safe: lists sharing a pool must stay on one thread.
+ */
+template <typename Node>
+class NodePool
+{
+public:
+    static constexpr size_t FIRST_SLAB = 64;
+    static constexpr size_t MAX_SLAB = 4096;
+
+    NodePool() = default;
+    NodePool(const NodePool &rhs) = delete;
+    NodePool &operator=(const NodePool &rhs) = delete;
+
+    ~NodePool()
+    {
+        for (std::pair<Node *, size_t> &slab : slabs)
+            std::allocator<Node>().deallocate(slab.first, slab.second);
+    }
+
+    Node *allocate()
+    {
+        if (freeList == nullptr)
+            grow();
+        Node *node = freeList;
+        freeList = *reinterpret_cast<Node **>(node);
+        return node;
+    }
+
+    void release(Node *node)
+    {
+        *reinterpret_cast<Node **>(node) = freeList;
+        freeList = node;
+    }
+
+    /**
+     * @brief Nodes in all slabs, free or in use
+     */
+    size_t capacity() const
+    {
+        size_t total = 0;
+        for (const std::pair<Node *, size_t> &slab : slabs)
+            total += slab.second;
+        return total;
+    }
+
+private:
+    static_assert(sizeof(Node) >= sizeof(Node *), "a free node stores the next free node in place");
+
+    Node *freeList = nullptr;
+    std::vector<std::pair<Node *, size_t>> slabs;
+    size_t nextSlab = FIRST_SLAB;
+
+    void grow()
+    {
+        size_t count = nextSlab;
+        nextSlab = std::min(nextSlab * 2, MAX_SLAB);
+        Node *slab = std::allocator<Node>().allocate(count);
+        slabs.push_back({slab, count});
+        for (size_t i = count; i > 0; i--)
+            release(slab + i - 1);
+    }
+};
+
+/**
+ * @brief Links shared by list nodes and the list's sentinel
+ */
+struct ListLink
+{
+    ListLink *prev;
+    ListLink *next;
+};
+
+/**
+ * @brief Doubly linked list whose nodes come from a NodePool
+ *
+ * A circular sentinel stands before the first and after the last node, so no
+ * insertion or removal has a special case. Lists built from the same pool (see
+ * List(pool)) can splice nodes between them in O(1); splicing from a list with a
+ * different pool moves the elements instead.
+ */
+template <typename Object>
+class List
+{
+private:
+    struct Node : ListLink
+    {
+        Object data;
+
+        template <typename... Args>
+        Node(Args &&...args) : data(std::forward<Args>(args)...)
+        {}
+    };
+
+public:
+    typedef NodePool<Node> Pool;
+
+    class const_iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Object value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Object *pointer;
+        typedef const Object &reference;
+
+        const_iterator() : current{nullptr}
+        {}
+
+        const Object &operator*() const
+        {
+            return static_cast<Node *>(current)->data;
+        }
+
+        const Object *operator->() const
+        {
+            return &static_cast<Node *>(current)->data;
+        }
+
+        const_iterator &operator++()
+        {
+            current = current->next;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        const_iterator &operator--()
+        {
+            current = current->prev;
+            return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+            const_iterator old = *this;
+            --(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator &rhs) const
+        {
+            return current == rhs.current;
+        }
+
+        bool operator!=(const const_iterator &rhs) const
+        {
+            return current != rhs.current;
+        }
+
+    protected:
+        ListLink *current;
+
+        const_iterator(ListLink *link) : current{link}
+        {}
+
+        friend class List<Object>;
+    };
+
+    class iterator : public const_iterator
+    {
+    public:
+        typedef Object *pointer;
+        typedef Object &reference;
+
+        iterator()
+        {}
+
+        Object &operator*() const
+        {
+            return static_cast<Node *>(this->current)->data;
+        }
+
+        Object *operator->() const
+        {
+            return &static_cast<Node *>(this->current)->data;
+        }
+
+        iterator &operator++()
+        {
+            this->current = this->current->next;
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        iterator &operator--()
+        {
+            this->current = this->current->prev;
+            return *this;
+        }
+
+        iterator operator--(int)
+        {
+            iterator old = *this;
+            --(*this);
+            return old;
+        }
+
+    protected:
+        iterator(ListLink *link) : const_iterator{link}
+        {}
+
+        friend class List<Object>;
+    };
+
+    List() : List(std::make_shared<Pool>())
+    {}
+
+    /**
+     * @brief Creates an empty list drawing nodes from pool, e.g. another list's pool()
+     */
+    explicit List(std::shared_ptr<Pool> pool) : nodes{std::move(pool)}, theSize{0}
+    {
+        sentinel.prev = sentinel.next = &sentinel;
+    }
+
+    List(const List &rhs) : List()
+    {
+        for (const Object &x : rhs)
+            push_back(x);
+    }
+
+    List &operator=(const List &rhs)
+    {
+        List copy = rhs;
+        swap(copy);
+        return *this;
+    }
+
+    List(List &&rhs) : List()
+    {
+        swap(rhs);
+    }
+
+    List &operator=(List &&rhs)
+    {
+        swap(rhs);
+        return *this;
+    }
+
+    ~List()
+    {
+        clear();
+    }
+
+    /**
+     * @brief Exchanges contents and pools with rhs in O(1)
+     */
+    void swap(List &rhs)
+    {
+        std::swap(nodes, rhs.nodes);
+        std::swap(theSize, rhs.theSize);
+        std::swap(sentinel, rhs.sentinel);
+        relinkSentinel();
+        rhs.relinkSentinel();
+    }
+
+    iterator begin()
+    {
+        return iterator(sentinel.next);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(sentinel.next);
+    }
+
+    iterator end()
+    {
+        return iterator(&sentinel);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(const_cast<ListLink *>(&sentinel));
+    }
+
+    int size() const
+    {
+        return theSize;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    void clear()
+    {
+        while (!empty())
+            pop_front();
+    }
+
+    Object &front()
+    {
+        if (empty())
+            throw EmptyListException();
+        return *begin();
+    }
+
+    const Object &front() const
+    {
+        if (empty())
+            throw EmptyListException();
+        return *begin();
+    }
+
+    Object &back()
+    {
+        if (empty())
+            throw EmptyListException();
+        return *--end();
+    }
+
+    const Object &back() const
+    {
+        if (empty())
+            throw EmptyListException();
+        return *--end();
+    }
+
+    void push_front(const Object &x)
+    {
+        insert(begin(), x);
+    }
+
+    void push_front(Object &&x)
+    {
+        insert(begin(), std::move(x));
+    }
+
+    void push_back(const Object &x)
+    {
+        insert(end(), x);
+    }
+
+    void push_back(Object &&x)
+    {
+        insert(end(), std::move(x));
+    }
+
+    void pop_front()
+    {
+        if (empty())
+            throw EmptyListException();
+        erase(begin());
+    }
+
+    void pop_back()
+    {
+        if (empty())
+            throw EmptyListException();
+        erase(--end());
+    }
+
+    iterator insert(iterator itr, const Object &x)
+    {
+        return emplace(itr, x);
+    }
+
+    iterator insert(iterator itr, Object &&x)
+    {
+        return emplace(itr, std::move(x));
+    }
+
+    /**
+     * @brief Constructs an element in a pooled node before itr
+     * @return Iterator to the new element
+     */
+    template <typename... Args>
+    iterator emplace(iterator itr, Args &&...args)
+    {
+        Node *node = nodes->allocate();
+        try
+        {
+            new (node) Node(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            nodes->release(node);
+            throw;
+        }
+        link(itr.current, node);
+        theSize++;
+        return iterator(node);
+    }
+
+    /**
+     * @brief Removes the element at itr and returns its node to the pool
+     * @return Iterator to the following element
+     */
+    iterator erase(iterator itr)
+    {
+        ListLink *next = itr.current->next;
+        unlink(itr.current);
+        Node *node = static_cast<Node *>(itr.current);
+        node->~Node();
+        nodes->release(node);
+        theSize--;
+        return iterator(next);
+    }
+
+    iterator erase(iterator from, iterator to)
+    {
+        while (from != to)
+            from = erase(from);
+        return to;
+    }
+
+    /**
+     * @brief Moves the element at itr of other before pos; O(1) when both lists share a pool
+     */
+    void splice(iterator pos, List &other, iterator itr)
+    {
+        // Splicing an element before itself or its successor leaves it where it is
+        if (pos.current == itr.current || pos.current == itr.current->next)
+            return;
+        if (nodes != other.nodes)
+        {
+            insert(pos, std::move(*itr));
+            other.erase(itr);
+            return;
+        }
+        other.unlink(itr.current);
+        other.theSize--;
+        link(pos.current, itr.current);
+        theSize++;
+    }
+
+    /**
+     * @brief Moves every element of other before pos; O(1) when both lists share a pool
+     */
+    void splice(iterator pos, List &other)
+    {
+        if (&other == this || other.empty())
+            return;
+        if (nodes != other.nodes)
+        {
+            while (!other.empty())
+                splice(pos, other, other.begin());
+            return;
+        }
+        ListLink *first = other.sentinel.next, *last = other.sentinel.prev;
+        other.sentinel.prev = other.sentinel.next = &other.sentinel;
+        first->prev = pos.current->prev;
+        last->next = pos.current;
+        pos.current->prev->next = first;
+        pos.current->prev = last;
+        theSize += other.theSize;
+        other.theSize = 0;
+    }
+
+    /**
+     * @brief The node pool, for building lists that splice with this one in O(1)
+     */
+    std::shared_ptr<Pool> pool() const
+    {
+        return nodes;
+    }
+
+private:
+    std::shared_ptr<Pool> nodes;
+    ListLink sentinel;
+    int theSize;
+
+    static void link(ListLink *before, ListLink *node)
+    {
+        node->prev = before->prev;
+        node->next = before;
+        before->prev->next = node;
+        before->prev = node;
+    }
+
+    static void unlink(ListLink *node)
+    {
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+    }
+
+    /**
+     * @brief Points the first and last nodes back at this list's sentinel after it was copied
+     */
+    void relinkSentinel()
+    {
+        if (theSize == 0)
+        {
+            sentinel.prev = sentinel.next = &sentinel;
+            return;
+        }
+        sentinel.next->prev = &sentinel;
+        sentinel.prev->next = &sentinel;
+    }
+};
+
+/**
+ * @brief Default number of elements per UnrolledList block: as many as fit in 256 bytes, at least 4
+ */
+template <typename Object>
+constexpr int unrolledCapacity()
+{
+    return std::max<int>(4, (256 - sizeof(ListLink) - sizeof(int)) / sizeof(Object));
+}
+
+/**
+ * @brief Unrolled linked list: each pooled node holds up to NODE_CAPACITY elements in an array
+ *
+ * Traversal touches one node per NODE_CAPACITY elements and reads them
+ * sequentially, so it runs close to array speed. Inserting into a full node
+ * splits it in half; erasing shifts the rest of the node and frees it once empty.
+ * Insertion and erasure invalidate iterators into the node they touch.
+ */
+template <typename Object, int NODE_CAPACITY = unrolledCapacity<Object>()>
+class UnrolledList
+{
+private:
+    struct Block : ListLink
+    {
+        int count;
+        alignas(Object) unsigned char storage[NODE_CAPACITY * sizeof(Object)];
+
+        Object *items()
+        {
+            return reinterpret_cast<Object *>(storage);
+        }
+    };
+
+public:
+    typedef NodePool<Block> Pool;
+
+    class const_iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Object value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Object *pointer;
+        typedef const Object &reference;
+
+        const_iterator() : block{nullptr}, index{0}
+        {}
+
+        const Object &operator*() const
+        {
+            return static_cast<Block *>(block)->items()[index];
+        }
+
+        const Object *operator->() const
+        {
+            return &**this;
+        }
+
+        const_iterator &operator++()
+        {
+            if (++index == static_cast<Block *>(block)->count)
+            {
+                block = block->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        const_iterator &operator--()
+        {
+            if (index-- == 0)
+            {
+                block = block->prev;
+                index = static_cast<Block *>(block)->count - 1;
+            }
+            return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+            const_iterator old = *this;
+            --(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator &rhs) const
+        {
+            return block == rhs.block && index == rhs.index;
+        }
+
+        bool operator!=(const const_iterator &rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    protected:
+        ListLink *block;
+        int index;
+
+        const_iterator(ListLink *block, int index) : block{block}, index{index}
+        {}
+
+        friend class UnrolledList<Object, NODE_CAPACITY>;
+    };
+
+    class iterator : public const_iterator
+    {
+    public:
+        typedef Object *pointer;
+        typedef Object &reference;
+
+        iterator()
+        {}
+
+        Object &operator*() const
+        {
+            return static_cast<Block *>(this->block)->items()[this->index];
+        }
+
+        Object *operator->() const
+        {
+            return &**this;
+        }
+
+        iterator &operator++()
+        {
+            const_iterator::operator++();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        iterator &operator--()
+        {
+            const_iterator::operator--();
+            return *this;
+        }
+
+        iterator operator--(int)
+        {
+            iterator old = *this;
+            --(*this);
+            return old;
+        }
+
+    protected:
+        iterator(ListLink *block, int index) : const_iterator{block, index}
+        {}
+
+        friend class UnrolledList<Object, NODE_CAPACITY>;
+    };
+
+    UnrolledList() : blocks{std::make_shared<Pool>()}, theSize{0}
+    {
+        sentinel.prev = sentinel.next = &sentinel;
+    }
+
+    UnrolledList(const UnrolledList &rhs) : UnrolledList()
+    {
+        for (const Object &x : rhs)
+            push_back(x);
+    }
+
+    UnrolledList &operator=(const UnrolledList &rhs)
+    {
+        UnrolledList copy = rhs;
+        std::swap(*this, copy);
+        return *this;
+    }
+
+    UnrolledList(UnrolledList &&rhs) : UnrolledList()
+    {
+        *this = std::move(rhs);
+    }
+
+    UnrolledList &operator=(UnrolledList &&rhs)
+    {
+        std::swap(blocks, rhs.blocks);
+        std::swap(theSize, rhs.theSize);
+        std::swap(sentinel, rhs.sentinel);
+        relinkSentinel();
+        rhs.relinkSentinel();
+        return *this;
+    }
+
+    ~UnrolledList()
+    {
+        clear();
+    }
+
+    iterator begin()
+    {
+        return iterator(sentinel.next, 0);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(sentinel.next, 0);
+    }
+
+    iterator end()
+    {
+        return iterator(&sentinel, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(const_cast<ListLink *>(&sentinel), 0);
+    }
+
+    int size() const
+    {
+        return theSize;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    void clear()
+    {
+        while (sentinel.next != &sentinel)
+        {
+            Block *block = static_cast<Block *>(sentinel.next);
+            for (int i = 0; i < block->count; i++)
+                block->items()[i].~Object();
+            freeBlock(block);
+        }
+        theSize = 0;
+    }
+
+    Object &front()
+    {
+        if (empty())
+            throw EmptyListException();
+        return *begin();
+    }
+
+    Object &back()
+    {
+        if (empty())
+            throw EmptyListException();
+        return *--end();
+    }
+
+    void push_back(const Object &x)
+    {
+        insert(end(), Object(x));
+    }
+
+    void push_back(Object &&x)
+    {
+        insert(end(), std::move(x));
+    }
+
+    void push_front(const Object &x)
+    {
+        insert(begin(), Object(x));
+    }
+
+    void push_front(Object &&x)
+    {
+        insert(begin(), std::move(x));
+    }
+
+    void pop_front()
+    {
+        if (empty())
+            throw EmptyListException();
+        erase(begin());
+    }
+
+    void pop_back()
+    {
+        if (empty())
+            throw EmptyListException();
+        erase(--end());
+    }
+
+    iterator insert(iterator itr, const Object &x)
+    {
+        return insert(itr, Object(x));
+    }
+
+    /**
+     * @brief Inserts x before itr
+     * @return Iterator to the new element
+     */
+    iterator insert(iterator itr, Object &&x)
+    {
+        Block *block;
+        int index;
+        if (itr.block == &sentinel)
+        {
+            // Appending: fill the last block, then start a new one
+            block = static_cast<Block *>(sentinel.prev);
+            if (block == &sentinel || block->count == NODE_CAPACITY)
+                block = newBlockBefore(&sentinel);
+            index = block->count;
+        }
+        else
+        {
+            block = static_cast<Block *>(itr.block);
+            index = itr.index;
+            if (index == 0 && block->prev != &sentinel && static_cast<Block *>(block->prev)->count < NODE_CAPACITY)
+            {
+                // Before the first element of a block: the end of the previous block is the same position
+                block = static_cast<Block *>(block->prev);
+                index = block->count;
+            }
+            else if (block->count == NODE_CAPACITY)
+            {
+                Block *upper = split(block);
+                if (index > block->count)
+                {
+                    index -= block->count;
+                    block = upper;
+                }
+            }
+        }
+        insertAt(block, index, std::move(x));
+        theSize++;
+        return iterator(block, index);
+    }
+
+    /**
+     * @brief Removes the element at itr
+     * @return Iterator to the following element
+     */
+    iterator erase(iterator itr)
+    {
+        Block *block = static_cast<Block *>(itr.block);
+        int index = itr.index;
+        Object *items = block->items();
+        for (int i = index; i + 1 < block->count; i++)
+            items[i] = std::move(items[i + 1]);
+        items[--block->count].~Object();
+        theSize--;
+        if (block->count == 0)
+        {
+            ListLink *next = block->next;
+            freeBlock(block);
+            return iterator(next, 0);
+        }
+        if (index == block->count)
+            return iterator(block->next, 0);
+        return iterator(block, index);
+    }
+
+    /**
+     * @brief Blocks in use, for checking how full they are
+     */
+    int blockCount() const
+    {
+        int count = 0;
+        for (const ListLink *link = sentinel.next; link != &sentinel; link = link->next)
+            count++;
+        return count;
+    }
+
+private:
+    std::shared_ptr<Pool> blocks;
+    ListLink sentinel;
+    int theSize;
+
+    Block *newBlockBefore(ListLink *before)
+    {
+        Block *block = blocks->allocate();
+        block->count = 0;
+        block->prev = before->prev;
+        block->next = before;
+        before->prev->next = block;
+        before->prev = block;
+        return block;
+    }
+
+    void freeBlock(Block *block)
+    {
+        block->prev->next = block->next;
+        block->next->prev = block->prev;
+        blocks->release(block);
+    }
+
+    /**
+     * @brief Moves the upper half of a full block into a new block after it
+     * @return The new block
+     */
+    Block *split(Block *block)
+    {
+        Block *upper = newBlockBefore(block->next);
+        int keep = block->count / 2;
+        Object *from = block->items(), *to = upper->items();
+        for (int i = keep; i < block->count; i++)
+        {
+            new (to + i - keep) Object(std::move(from[i]));
+            from[i].~Object();
+        }
+        upper->count = block->count - keep;
+        block->count = keep;
+        return upper;
+    }
+
+    /**
+     * @brief Inserts x at index of a block with room, shifting the elements after it
+     */
+    static void insertAt(Block *block, int index, Object &&x)
+    {
+        Object *items = block->items();
+        if (index == block->count)
+        {
+            new (items + index) Object(std::move(x));
+        }
+        else
+        {
+            new (items + block->count) Object(std::move(items[block->count - 1]));
+            for (int i = block->count - 1; i > index; i--)
+                items[i] = std::move(items[i - 1]);
+            items[index] = std::move(x);
+        }
+        block->count++;
+    }
+
+    void relinkSentinel()
+    {
+        if (theSize == 0)
+        {
+            sentinel.prev = sentinel.next = &sentinel;
+            return;
+        }
+        sentinel.next->prev = &sentinel;
+        sentinel.prev->next = &sentinel;
+    }
+};
+#endif
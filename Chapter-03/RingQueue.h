@@ -0,0 +1,336 @@
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+#include <cstddef>
+
+/**
+ * @brief Exception thrown when a queue is created with no room
+ */
+class QueueCapacityException {};
+
+/**
+ * @brief Rounds a queue capacity up to a power of two so indices wrap with a mask
+ */
+inline size_t ringCapacity(size_t capacity)
+{
+    if (capacity == 0)
+        throw QueueCapacityException();
+    size_t rounded = 1;
+    while (rounded < capacity)
+        rounded *= 2;
+    return rounded;
+}
+
+/**
+ * @brief Bounded single-producer single-consumer queue on a ring buffer
+ *
+ * The producer owns tail and the consumer owns head; each index sits on its own
+ * cache line with that side's cached copy of the other index, so the two threads
+ * only touch each other's line when the cached copy says the queue looks full or
+ * empty. Exactly one thread may enqueue and one thread may dequeue.
+ */
+template <typename Object>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(size_t capacity) : mask{ringCapacity(capacity) - 1}
+    {
+        slots = std::allocator<Object>().allocate(mask + 1);
+    }
+
+    SpscQueue(const SpscQueue &rhs) = delete;
+    SpscQueue &operator=(const SpscQueue &rhs) = delete;
+
+    ~SpscQueue()
+    {
+        size_t tail = producer.index.load(std::memory_order_acquire);
+        for (size_t head = consumer.index.load(std::memory_order_relaxed); head != tail; head++)
+            slots[head & mask].~Object();
+        std::allocator<Object>().deallocate(slots, mask + 1);
+    }
+
+    /**
+     * @brief Adds x unless the queue is full; producer thread only
+     * @return false if the queue was full
+     */
+    template <typename Value>
+    bool tryEnqueue(Value &&x)
+    {
+        size_t tail = producer.index.load(std::memory_order_relaxed);
+        if (tail - producer.cached > mask)
+        {
+            producer.cached = consumer.index.load(std::memory_order_acquire);
+            if (tail - producer.cached > mask)
+                return false;
+        }
+        new (slots + (tail & mask)) Object(std::forward<Value>(x));
+        producer.index.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element into x unless the queue is empty; consumer thread only
+     * @return false if the queue was empty
+     */
+    bool tryDequeue(Object &x)
+    {
+        Object *slot = front();
+        if (slot == nullptr)
+            return false;
+        x = std::move(*slot);
+        popFront();
+        return true;
+    }
+
+    /**
+     * @brief Adds x, yielding while the queue is full
+     */
+    template <typename Value>
+    void enqueue(Value &&x)
+    {
+        while (!tryEnqueue(std::forward<Value>(x)))
+            std::this_thread::yield();
+    }
+
+    /**
+     * @brief Removes the oldest element, yielding while the queue is empty
+     */
+    Object dequeue()
+    {
+        Object *slot;
+        while ((slot = front()) == nullptr)
+            std::this_thread::yield();
+        Object x(std::move(*slot));
+        popFront();
+        return x;
+    }
+
+    size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+    /**
+     * @brief Elements in the queue; exact only when neither side is running
+     */
+    size_t size() const
+    {
+        return producer.index.load(std::memory_order_acquire) - consumer.index.load(std::memory_order_acquire);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    struct alignas(64) Side
+    {
+        std::atomic<size_t> index{0}; ///< Next slot this side will use
+        size_t cached = 0;            ///< This side's last read of the other side's index
+    };
+
+    Side producer;
+    Side consumer;
+    const size_t mask;
+    Object *slots;
+
+    /**
+     * @brief The oldest element, or nullptr if the queue is empty; consumer thread only
+     */
+    Object *front()
+    {
+        size_t head = consumer.index.load(std::memory_order_relaxed);
+        if (head == consumer.cached)
+        {
+            consumer.cached = producer.index.load(std::memory_order_acquire);
+            if (head == consumer.cached)
+                return nullptr;
+        }
+        return slots + (head & mask);
+    }
+
+    /**
+     * @brief Destroys the element returned by front() and hands its slot back to the producer
+     */
+    void popFront()
+    {
+        size_t head = consumer.index.load(std::memory_order_relaxed);
+        slots[head & mask].~Object();
+        consumer.index.store(head + 1, std::memory_order_release);
+    }
+};
+
+/**
+ * @brief Bounded multi-producer multi-consumer queue on a ring buffer
+ *
+ * Each slot carries a sequence number saying whose turn it is: equal to the
+ * position, the slot is free for the producer claiming that position; one
+ * past it, the slot holds an element for the consumer of that position. A
+ * thread claims a position with a compare-and-swap on the shared index and
+ * never waits for another thread inside an operation. The two indices sit on
+ * separate cache lines from each other and from the slots.
+ *
+ * With a single slot, "full for this position" and "free for the next position"
+ * would be the same sequence number, so the ring has at least two slots.
+ */
+template <typename Object>
+class MpmcQueue
+{
+public:
+    explicit MpmcQueue(size_t capacity) : mask{std::max<size_t>(ringCapacity(capacity), 2) - 1}
+    {
+        slots = std::allocator<Slot>().allocate(mask + 1);
+        for (size_t i = 0; i <= mask; i++)
+        {
+            new (slots + i) Slot;
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue &rhs) = delete;
+    MpmcQueue &operator=(const MpmcQueue &rhs) = delete;
+
+    ~MpmcQueue()
+    {
+        size_t last = tail.load(std::memory_order_acquire);
+        for (size_t position = head.load(std::memory_order_relaxed); position != last; position++)
+            slots[position & mask].object()->~Object();
+        std::allocator<Slot>().deallocate(slots, mask + 1);
+    }
+
+    /**
+     * @brief Adds x unless the queue is full; safe from any number of threads
+     * @return false if the queue was full
+     */
+    template <typename Value>
+    bool tryEnqueue(Value &&x)
+    {
+        size_t position = tail.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot &slot = slots[position & mask];
+            // Signed so the comparison survives the indices wrapping around
+            std::ptrdiff_t turn = slot.sequence.load(std::memory_order_acquire) - position;
+            if (turn == 0)
+            {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    new (slot.object()) Object(std::forward<Value>(x));
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (turn < 0)
+                return false;
+            else
+                position = tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Removes the oldest element into x unless the queue is empty; safe from any number of threads
+     * @return false if the queue was empty
+     */
+    bool tryDequeue(Object &x)
+    {
+        size_t position;
+        Slot *slot = claim(position);
+        if (slot == nullptr)
+            return false;
+        x = std::move(*slot->object());
+        release(*slot, position);
+        return true;
+    }
+
+    template <typename Value>
+    void enqueue(Value &&x)
+    {
+        while (!tryEnqueue(std::forward<Value>(x)))
+            std::this_thread::yield();
+    }
+
+    Object dequeue()
+    {
+        size_t position;
+        Slot *slot;
+        while ((slot = claim(position)) == nullptr)
+            std::this_thread::yield();
+        Object x(std::move(*slot->object()));
+        release(*slot, position);
+        return x;
+    }
+
+    size_t capacity() const
+    {
+        return mask + 1;
+    }
+
+    /**
+     * @brief Elements in the queue; exact only when no thread is using it
+     */
+    size_t size() const
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        alignas(Object) unsigned char storage[sizeof(Object)];
+
+        Object *object()
+        {
+            return reinterpret_cast<Object *>(storage);
+        }
+    };
+
+    alignas(64) std::atomic<size_t> tail{0}; ///< Next position to enqueue
+    alignas(64) std::atomic<size_t> head{0}; ///< Next position to dequeue
+    alignas(64) const size_t mask;
+    Slot *slots;
+
+    /**
+     * @brief Claims the oldest element for this thread, or returns nullptr if the queue is empty
+     * @param position Set to the claimed position
+     */
+    Slot *claim(size_t &position)
+    {
+        position = head.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot &slot = slots[position & mask];
+            std::ptrdiff_t turn = slot.sequence.load(std::memory_order_acquire) - (position + 1);
+            if (turn == 0)
+            {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    return &slot;
+            }
+            else if (turn < 0)
+                return nullptr;
+            else
+                position = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Destroys the element of a claimed slot and frees the slot for the producer one lap later
+     */
+    void release(Slot &slot, size_t position)
+    {
+        slot.object()->~Object();
+        slot.sequence.store(position + mask + 1, std::memory_order_release);
+    }
+};
+#endif
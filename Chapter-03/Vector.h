@@ -1,25 +1,32 @@
+#ifndef VECTOR_H
+#define VECTOR_H
 #include <algorithm>
+#include "../Chapter-01/container-stats.h"
 
 template <typename Object>
-class Vector
+class Vector : public InstrumentedContainer
 {
 public:
     explicit Vector(int initSize = 0) : theSize{initSize}, theCapacity{initSize + SPARE_CAPACITY}
     {
         objects = new Object[theCapacity];
+        countAllocation(theCapacity * sizeof(Object));
     }
 
-    Vector(const Vector &rhs) : theSize{rhs.theSize}, theCapacity{rhs.theCapacity}
+    Vector(const Vector &rhs) : InstrumentedContainer{}, theSize{rhs.theSize}, theCapacity{rhs.theCapacity}
     {
         objects = new Object[theCapacity];
         for (int i = 0; i < theSize; i++)
             objects[i] = rhs.objects[i];
+        countAllocation(theCapacity * sizeof(Object));
+        countCopies(theSize);
     }
 
     Vector &operator=(const Vector &rhs)
     {
         Vector copy = rhs;
         swap(*this, copy);
+        absorbStats(copy);
         return *this;
     }
 
@@ -58,6 +65,7 @@ public:
         Object *newArray = new Object[newCapacity];
         for (int i = 0; i < theSize; i++)
             newArray[i] = std::move(objects[i]);
+        countReallocation(theCapacity, newCapacity, theSize, sizeof(Object));
         theCapacity = newCapacity;
         std::swap(objects, newArray);
         delete[] newArray;
@@ -93,6 +101,7 @@ public:
         if (theSize == theCapacity)
             reserve(2 * theCapacity + 1);
         objects[theSize++] = x;
+        countCopies(1);
     }
 
     void push_back(Object &&x)
@@ -100,6 +109,7 @@ public:
         if (theSize == theCapacity)
             reserve(2 * theCapacity + 1);
         objects[theSize++] = std::move(x);
+        countMoves(1);
     }
 
     void pop_back()
@@ -140,4 +150,5 @@ private:
     int theSize;
     int theCapacity;
     Object *objects;
-};
\ No newline at end of file
+};
+#endif
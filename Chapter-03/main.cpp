@@ -0,0 +1,267 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <string>
+#include "List.h"
+#include "RingQueue.h"
+#include "ConcurrentVector.h"
+
+/**
+ * @brief Queue element with no default constructor that counts its live copies
+ */
+struct Ticket
+{
+    static std::atomic<long> live;
+
+    long producer;
+    long value;
+
+    Ticket(long producer, long value) : producer{producer}, value{value}
+    {
+        live++;
+    }
+
+    Ticket(const Ticket &rhs) : producer{rhs.producer}, value{rhs.value}
+    {
+        live++;
+    }
+
+    Ticket &operator=(const Ticket &rhs) = default;
+
+    ~Ticket()
+    {
+        live--;
+    }
+};
+
+std::atomic<long> Ticket::live{0};
+
+int failures = 0;
+
+/**
+ * @brief Tells whether a list holds exactly the values of expected, in order
+ */
+template <typename Container>
+bool sameContents(Container &list, const std::vector<int> &expected)
+{
+    if ((size_t)list.size() != expected.size())
+        return false;
+    size_t i = 0;
+    for (int x : list)
+        if (x != expected[i++])
+            return false;
+    return true;
+}
+
+void check(bool passed, const char *what)
+{
+    std::cout << (passed ? "ok      " : "FAILED  ") << what << std::endl;
+    if (!passed)
+        failures++;
+}
+
+void checkSpscQueue()
+{
+    const long count = 100000;
+    long sum = 0;
+    bool ordered = true;
+    {
+        SpscQueue<Ticket> queue(64);
+        std::thread producer([&queue]()
+        {
+            for (long i = 0; i < count; i++)
+                queue.enqueue(Ticket(0, i));
+        });
+        for (long i = 0; i < count; i++)
+        {
+            Ticket ticket = queue.dequeue();
+            ordered = ordered && ticket.value == i;
+            sum += ticket.value;
+        }
+        producer.join();
+        check(ordered && sum == count * (count - 1) / 2, "SpscQueue delivers every element in order");
+        check(queue.empty(), "SpscQueue is empty after draining");
+
+        while (queue.tryEnqueue(Ticket(0, 0)))
+            ;
+        check(queue.size() == queue.capacity(), "SpscQueue holds exactly its capacity");
+    }
+    check(Ticket::live == 0, "SpscQueue destroys the elements left in it");
+}
+
+void checkMpmcQueue()
+{
+    const int threads = 2;
+    const long count = 50000;
+    std::atomic<long> sum{0};
+    std::atomic<bool> ordered{true};
+    {
+        MpmcQueue<Ticket> queue(64);
+        std::vector<std::thread> workers;
+        for (int p = 0; p < threads; p++)
+            workers.emplace_back([&queue, p]()
+            {
+                for (long i = 0; i < count; i++)
+                    queue.enqueue(Ticket(p, i));
+            });
+        for (int c = 0; c < threads; c++)
+            workers.emplace_back([&]()
+            {
+                // Each consumer must see each producer's elements in the order they were enqueued
+                std::vector<long> last(threads, -1);
+                long local = 0;
+                for (long i = 0; i < count; i++)
+                {
+                    Ticket ticket = queue.dequeue();
+                    if (ticket.value <= last[ticket.producer])
+                        ordered = false;
+                    last[ticket.producer] = ticket.value;
+                    local += ticket.value;
+                }
+                sum += local;
+            });
+        for (std::thread &worker : workers)
+            worker.join();
+        check(ordered && sum == threads * count * (count - 1) / 2, "MpmcQueue delivers every element once, in order per producer");
+        check(queue.empty(), "MpmcQueue is empty after draining");
+
+        while (queue.tryEnqueue(Ticket(0, 0)))
+            ;
+        check(queue.size() == queue.capacity(), "MpmcQueue holds exactly its capacity");
+    }
+    check(Ticket::live == 0, "MpmcQueue destroys the elements left in it");
+}
+
+/**
+ * @brief Fills, drains and streams through a queue created with room for one element
+ */
+template <typename Queue>
+void checkSmallQueue(const char *fills, const char *drains, const char *streams)
+{
+    Queue queue(1);
+    size_t added = 0;
+    while (added < 4 && queue.tryEnqueue(std::to_string(added)))
+        added++;
+    check(added == queue.capacity() && queue.size() == queue.capacity(), fills);
+
+    bool ordered = true;
+    std::string x;
+    for (size_t i = 0; i < added; i++)
+        ordered = ordered && queue.tryDequeue(x) && x == std::to_string(i);
+    check(ordered && !queue.tryDequeue(x) && queue.empty(), drains);
+
+    const int count = 10000;
+    std::thread producer([&queue]()
+    {
+        for (int i = 0; i < count; i++)
+            queue.enqueue(std::to_string(i));
+    });
+    for (int i = 0; i < count; i++)
+        ordered = ordered && queue.dequeue() == std::to_string(i);
+    producer.join();
+    check(ordered && queue.empty(), streams);
+}
+
+void checkUnrolledList()
+{
+    UnrolledList<int, 4> list;
+    std::vector<int> reference;
+    std::mt19937 generator(7);
+    bool same = true;
+    for (int step = 0; step < 20000; step++)
+    {
+        // Grow for the first half, so blocks split, then shrink, so blocks empty and are freed
+        bool grow = reference.empty() || generator() % 100 < (step < 10000 ? 70 : 30);
+        size_t position = generator() % (reference.size() + (grow ? 1 : 0));
+        UnrolledList<int, 4>::iterator itr = list.begin();
+        for (size_t i = 0; i < position; i++)
+            ++itr;
+        if (grow)
+        {
+            list.insert(itr, step);
+            reference.insert(reference.begin() + position, step);
+        }
+        else
+        {
+            list.erase(itr);
+            reference.erase(reference.begin() + position);
+        }
+        if (step % 1000 == 999)
+            same = same && sameContents(list, reference);
+    }
+    check(same, "UnrolledList matches a vector through splits and erases");
+    check(list.blockCount() >= (list.size() + 3) / 4 && list.blockCount() <= list.size(),
+          "UnrolledList keeps no empty blocks");
+
+    while (!list.empty())
+        list.erase(list.begin());
+    check(list.blockCount() == 0, "UnrolledList frees every block when emptied");
+}
+
+void checkConcurrentVector()
+{
+    const int threads = 4;
+    const long count = 100000;
+    ConcurrentVector<long> vec;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+        workers.emplace_back([&vec, t]()
+        {
+            for (long i = t; i < threads * count; i += threads)
+                vec.push_back(i);
+        });
+    for (std::thread &worker : workers)
+        worker.join();
+
+    long sum = 0;
+    for (long x : vec)
+        sum += x;
+    check(vec.size() == (size_t)threads * count && sum == threads * count * (threads * count - 1) / 2,
+          "ConcurrentVector keeps every concurrent append");
+    check(vec.capacity() >= vec.size(), "ConcurrentVector capacity covers its size");
+}
+
+void checkListSelfSplice()
+{
+    List<int> list;
+    for (int i = 0; i < 5; i++)
+        list.push_back(i);
+    List<int>::iterator second = ++list.begin();
+    List<int>::iterator third = ++list.begin();
+    ++third;
+    list.splice(second, list, second);
+    check(sameContents(list, {0, 1, 2, 3, 4}), "List splicing an element before itself keeps the list intact");
+    list.splice(third, list, second);
+    check(sameContents(list, {0, 1, 2, 3, 4}), "List splicing an element before its successor keeps the list intact");
+
+    list.splice(list.begin(), list, --list.end());
+    check(sameContents(list, {4, 0, 1, 2, 3}), "List splicing within itself moves the element");
+}
+
+/**
+ * @brief Checks the Chapter 3 containers that have no other test
+ *
+ * Runs producers and consumers through SpscQueue and MpmcQueue, including queues
+ * created with room for a single element, random insertions
+ * and erasures through UnrolledList, concurrent appends through ConcurrentVector
+ * and splices of a List into itself, printing one line per check.
+ *
+ * @return Number of failed checks
+ */
+int main()
+{
+    checkSpscQueue();
+    checkMpmcQueue();
+    checkSmallQueue<SpscQueue<std::string>>("SpscQueue of capacity 1 holds exactly its capacity",
+                                            "SpscQueue of capacity 1 gives its elements back in order",
+                                            "SpscQueue of capacity 1 streams elements in order");
+    checkSmallQueue<MpmcQueue<std::string>>("MpmcQueue of capacity 1 holds exactly its capacity",
+                                            "MpmcQueue of capacity 1 gives its elements back in order",
+                                            "MpmcQueue of capacity 1 streams elements in order");
+    checkUnrolledList();
+    checkConcurrentVector();
+    checkListSelfSplice();
+    return failures;
+}
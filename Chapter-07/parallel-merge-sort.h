@@ -0,0 +1,132 @@
+#ifndef PARALLEL_MERGE_SORT_H
+#define PARALLEL_MERGE_SORT_H
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+using namespace std;
+
+/**
+ * @brief Ranges below this size are merged or sorted on the calling thread
+ */
+const size_t PARALLEL_MERGE_CUTOFF = 1 << 13;
+
+/**
+ * @brief Ranges below this size are sorted with insertion sort
+ */
+const size_t MERGE_SORT_INSERTION_CUTOFF = 32;
+
+/**
+ * @brief Stably merges x[0, nx) and y[0, ny) into out, splitting the work across threads
+ *
+ * The larger input is split at its middle element and the other input at the matching
+ * lower or upper bound, so both halves can be merged independently.
+ *
+ * @param numThreads Number of threads available to this merge
+ */
+template <typename Object, typename Comparator>
+void parallelMerge(Object* x, size_t nx, Object* y, size_t ny, Object* out, Comparator less, int numThreads)
+{
+    if (numThreads <= 1 || nx + ny < PARALLEL_MERGE_CUTOFF)
+    {
+        merge(make_move_iterator(x), make_move_iterator(x + nx),
+              make_move_iterator(y), make_move_iterator(y + ny), out, less);
+        return;
+    }
+
+    size_t mx, my;
+    if (nx >= ny)
+    {
+        mx = nx / 2;
+        my = lower_bound(y, y + ny, x[mx], less) - y;
+    }
+    else
+    {
+        my = ny / 2;
+        mx = upper_bound(x, x + nx, y[my], less) - x;
+    }
+
+    thread left(parallelMerge<Object, Comparator>, x, mx, y, my, out, less, numThreads / 2);
+    parallelMerge(x + mx, nx - mx, y + my, ny - my, out + mx + my, less, numThreads - numThreads / 2);
+    left.join();
+}
+
+/**
+ * @brief Merge sorts a[0, n), leaving the result in b if intoScratch is set and in a otherwise
+ *
+ * The two buffers swap roles at every level so that no copy-back pass is needed.
+ */
+template <typename Object, typename Comparator>
+void mergeSortRange(Object* a, Object* b, size_t n, bool intoScratch, Comparator less, int numThreads)
+{
+    if (n <= MERGE_SORT_INSERTION_CUTOFF)
+    {
+        for (size_t i = 1; i < n; i++)
+        {
+            Object tmp = std::move(a[i]);
+            size_t j = i;
+            for (; j > 0 && less(tmp, a[j - 1]); j--)
+                a[j] = std::move(a[j - 1]);
+            a[j] = std::move(tmp);
+        }
+        if (intoScratch)
+            move(a, a + n, b);
+        return;
+    }
+
+    size_t center = n / 2;
+    if (numThreads > 1 && n >= PARALLEL_MERGE_CUTOFF)
+    {
+        thread left(mergeSortRange<Object, Comparator>, a, b, center, !intoScratch, less, numThreads / 2);
+        mergeSortRange(a + center, b + center, n - center, !intoScratch, less, numThreads - numThreads / 2);
+        left.join();
+    }
+    else
+    {
+        mergeSortRange(a, b, center, !intoScratch, less, 1);
+        mergeSortRange(a + center, b + center, n - center, !intoScratch, less, 1);
+    }
+
+    // The sorted halves are in the buffer we are not writing to
+    Object* from = intoScratch ? a : b;
+    Object* to = intoScratch ? b : a;
+    parallelMerge(from, center, from + center, n - center, to, less, numThreads);
+}
+
+/**
+ * @brief Stably sorts a contiguous range with a multithreaded merge sort
+ *
+ * Both the recursive halves and every merge are split across threads, so the span
+ * is polylogarithmic instead of being bounded by a final sequential merge.
+ *
+ * @param begin Contiguous iterator to the first element
+ * @param end Contiguous iterator past the last element
+ * @param less Strict weak ordering
+ * @param numThreads Number of threads to use (rounded down to at least 1)
+ *
+ * @note Complexity: O(N log N) work, O(N) extra space
+ */
+template <typename Iterator, typename Comparator>
+void parallelMergeSort(Iterator begin, Iterator end, Comparator less, int numThreads)
+{
+    typedef typename iterator_traits<Iterator>::value_type Object;
+    size_t n = end - begin;
+    if (n < 2)
+        return;
+
+    vector<Object> scratch(n);
+    mergeSortRange(&*begin, scratch.data(), n, false, less, max(numThreads, 1));
+}
+
+/**
+ * @brief Stably sorts a contiguous range in ascending order using all hardware threads
+ */
+template <typename Iterator>
+void parallelMergeSort(Iterator begin, Iterator end)
+{
+    parallelMergeSort(begin, end, less<typename iterator_traits<Iterator>::value_type>(),
+                      max(1u, thread::hardware_concurrency()));
+}
+
+#endif
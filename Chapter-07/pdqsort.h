@@ -0,0 +1,293 @@
+#ifndef PDQSORT_H
+#define PDQSORT_H
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+using namespace std;
+
+/**
+ * @brief Threshold below which insertion sort is used
+ */
+const int PDQ_INSERTION_SORT_THRESHOLD = 24;
+
+/**
+ * @brief Threshold above which the pivot is a pseudo-median of nine
+ */
+const int PDQ_NINTHER_THRESHOLD = 128;
+
+/**
+ * @brief Maximum element moves a partial insertion sort may do before giving up
+ */
+const int PDQ_PARTIAL_INSERTION_SORT_LIMIT = 8;
+
+/**
+ * @brief Sorts [begin, end) with insertion sort
+ * @param unguarded true if *(begin - 1) is known to be <= every element in the range
+ */
+template <typename Iterator, typename Comparator>
+void pdqInsertionSort(Iterator begin, Iterator end, Comparator less, bool unguarded)
+{
+    if (begin == end)
+        return;
+
+    for (Iterator current = begin + 1; current != end; ++current)
+    {
+        if (!less(*current, *(current - 1)))
+            continue;
+
+        auto tmp = std::move(*current);
+        Iterator hole = current;
+        do
+        {
+            *hole = std::move(*(hole - 1));
+            --hole;
+        } while ((unguarded || hole != begin) && less(tmp, *(hole - 1)));
+        *hole = std::move(tmp);
+    }
+}
+
+/**
+ * @brief Attempts to finish an almost sorted range with insertion sort
+ * @return false if more than PDQ_PARTIAL_INSERTION_SORT_LIMIT moves were needed
+ */
+template <typename Iterator, typename Comparator>
+bool pdqPartialInsertionSort(Iterator begin, Iterator end, Comparator less)
+{
+    if (begin == end)
+        return true;
+
+    int moves = 0;
+    for (Iterator current = begin + 1; current != end; ++current)
+    {
+        if (!less(*current, *(current - 1)))
+            continue;
+
+        auto tmp = std::move(*current);
+        Iterator hole = current;
+        do
+        {
+            *hole = std::move(*(hole - 1));
+            --hole;
+        } while (hole != begin && less(tmp, *(hole - 1)));
+        *hole = std::move(tmp);
+
+        moves += current - hole;
+        if (moves > PDQ_PARTIAL_INSERTION_SORT_LIMIT)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Orders *a, *b, *c so that *b holds their median
+ */
+template <typename Iterator, typename Comparator>
+void pdqSort3(Iterator a, Iterator b, Iterator c, Comparator less)
+{
+    if (less(*b, *a)) iter_swap(a, b);
+    if (less(*c, *b)) iter_swap(b, c);
+    if (less(*b, *a)) iter_swap(a, b);
+}
+
+/**
+ * @brief Partitions around *begin, putting elements equal to the pivot on the right
+ * @return Pair of (final pivot position, whether the range was already partitioned)
+ */
+template <typename Iterator, typename Comparator>
+pair<Iterator, bool> pdqPartitionRight(Iterator begin, Iterator end, Comparator less)
+{
+    auto pivot = std::move(*begin);
+    Iterator first = begin;
+    Iterator last = end;
+
+    // The median-of-3 guarantees a sentinel on both sides for the first scans
+    while (less(*++first, pivot));
+
+    if (first - 1 == begin)
+        while (first < last && !less(*--last, pivot));
+    else
+        while (!less(*--last, pivot));
+
+    bool alreadyPartitioned = first >= last;
+
+    while (first < last)
+    {
+        iter_swap(first, last);
+        while (less(*++first, pivot));
+        while (!less(*--last, pivot));
+    }
+
+    Iterator pivotPosition = first - 1;
+    *begin = std::move(*pivotPosition);
+    *pivotPosition = std::move(pivot);
+    return make_pair(pivotPosition, alreadyPartitioned);
+}
+
+/**
+ * @brief Partitions around *begin, putting elements equal to the pivot on the left
+ *
+ * Used when the pivot equals the element preceding the range, so every element
+ * equal to it is already in its final place and only the right part is recursed.
+ *
+ * @return Final pivot position
+ */
+template <typename Iterator, typename Comparator>
+Iterator pdqPartitionLeft(Iterator begin, Iterator end, Comparator less)
+{
+    auto pivot = std::move(*begin);
+    Iterator first = begin;
+    Iterator last = end;
+
+    while (less(pivot, *--last));
+
+    if (last + 1 == end)
+        while (first < last && !less(pivot, *++first));
+    else
+        while (!less(pivot, *++first));
+
+    while (first < last)
+    {
+        iter_swap(first, last);
+        while (less(pivot, *--last));
+        while (!less(pivot, *++first));
+    }
+
+    Iterator pivotPosition = last;
+    *begin = std::move(*pivotPosition);
+    *pivotPosition = std::move(pivot);
+    return pivotPosition;
+}
+
+/**
+ * @brief Recursive pattern-defeating quicksort loop
+ * @param badAllowed Number of unbalanced partitions left before falling back to heapsort
+ * @param leftmost true if the range has no element to its left acting as sentinel
+ */
+template <typename Iterator, typename Comparator>
+void pdqSortLoop(Iterator begin, Iterator end, Comparator less, int badAllowed, bool leftmost = true)
+{
+    while (true)
+    {
+        auto size = end - begin;
+
+        if (size < PDQ_INSERTION_SORT_THRESHOLD)
+        {
+            pdqInsertionSort(begin, end, less, !leftmost);
+            return;
+        }
+
+        // Median of 3, or pseudo-median of 9 for large ranges, ends up in *begin
+        auto half = size / 2;
+        if (size > PDQ_NINTHER_THRESHOLD)
+        {
+            pdqSort3(begin, begin + half, end - 1, less);
+            pdqSort3(begin + 1, begin + (half - 1), end - 2, less);
+            pdqSort3(begin + 2, begin + (half + 1), end - 3, less);
+            pdqSort3(begin + (half - 1), begin + half, begin + (half + 1), less);
+            iter_swap(begin, begin + half);
+        }
+        else
+            pdqSort3(begin + half, begin, end - 1, less);
+
+        // Many equal elements: the pivot equals the sentinel, so skip them all at once
+        if (!leftmost && !less(*(begin - 1), *begin))
+        {
+            begin = pdqPartitionLeft(begin, end, less) + 1;
+            continue;
+        }
+
+        pair<Iterator, bool> partition = pdqPartitionRight(begin, end, less);
+        Iterator pivotPosition = partition.first;
+        bool alreadyPartitioned = partition.second;
+
+        auto leftSize = pivotPosition - begin;
+        auto rightSize = end - (pivotPosition + 1);
+        bool highlyUnbalanced = leftSize < size / 8 || rightSize < size / 8;
+
+        if (highlyUnbalanced)
+        {
+            if (--badAllowed == 0)
+            {
+                make_heap(begin, end, less);
+                sort_heap(begin, end, less);
+                return;
+            }
+
+            // Break adversarial patterns by swapping a few elements around
+            if (leftSize >= PDQ_INSERTION_SORT_THRESHOLD)
+            {
+                iter_swap(begin, begin + leftSize / 4);
+                iter_swap(pivotPosition - 1, pivotPosition - leftSize / 4);
+                if (leftSize > PDQ_NINTHER_THRESHOLD)
+                {
+                    iter_swap(begin + 1, begin + (leftSize / 4 + 1));
+                    iter_swap(begin + 2, begin + (leftSize / 4 + 2));
+                    iter_swap(pivotPosition - 2, pivotPosition - (leftSize / 4 + 1));
+                    iter_swap(pivotPosition - 3, pivotPosition - (leftSize / 4 + 2));
+                }
+            }
+            if (rightSize >= PDQ_INSERTION_SORT_THRESHOLD)
+            {
+                iter_swap(pivotPosition + 1, pivotPosition + (1 + rightSize / 4));
+                iter_swap(end - 1, end - rightSize / 4);
+                if (rightSize > PDQ_NINTHER_THRESHOLD)
+                {
+                    iter_swap(pivotPosition + 2, pivotPosition + (2 + rightSize / 4));
+                    iter_swap(pivotPosition + 3, pivotPosition + (3 + rightSize / 4));
+                    iter_swap(end - 2, end - (1 + rightSize / 4));
+                    iter_swap(end - 3, end - (2 + rightSize / 4));
+                }
+            }
+        }
+        else if (alreadyPartitioned
+                 && pdqPartialInsertionSort(begin, pivotPosition, less)
+                 && pdqPartialInsertionSort(pivotPosition + 1, end, less))
+        {
+            // Sorted (or nearly sorted) input finishes in linear time
+            return;
+        }
+
+        // Recurse into the left part, loop on the right part
+        pdqSortLoop(begin, pivotPosition, less, badAllowed, leftmost);
+        begin = pivotPosition + 1;
+        leftmost = false;
+    }
+}
+
+/**
+ * @brief Sorts [begin, end) with pattern-defeating quicksort
+ *
+ * Quicksort with median-of-3 / ninther pivots, a linear pass for sorted or nearly
+ * sorted runs, a three-way split for runs of equal keys and a heapsort fallback
+ * that bounds the worst case.
+ *
+ * @param begin Random-access iterator to the first element
+ * @param end Random-access iterator past the last element
+ * @param less Strict weak ordering
+ *
+ * @note Complexity: O(N log N) worst case, O(N) for sorted input and few distinct keys
+ * @note Not stable
+ */
+template <typename Iterator, typename Comparator>
+void pdqsort(Iterator begin, Iterator end, Comparator less)
+{
+    if (end - begin < 2)
+        return;
+
+    int log2Size = 0;
+    for (auto size = end - begin; size > 1; size >>= 1)
+        log2Size++;
+    pdqSortLoop(begin, end, less, log2Size);
+}
+
+/**
+ * @brief Sorts [begin, end) in ascending order with pattern-defeating quicksort
+ */
+template <typename Iterator>
+void pdqsort(Iterator begin, Iterator end)
+{
+    pdqsort(begin, end, less<typename iterator_traits<Iterator>::value_type>());
+}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <iterator>
+#include <utility>
+using namespace std;
+
+/**
+ * @brief Maps an integer or floating-point key to an unsigned key with the same order
+ *
+ * Signed integers get their sign bit flipped. Floats get all bits flipped when
+ * negative and only the sign bit flipped otherwise, so that comparing the unsigned
+ * results gives the IEEE-754 total order (NaNs sort to the ends).
+ *
+ * @tparam Key Arithmetic key type
+ */
+template <typename Key, bool IsFloat = is_floating_point<Key>::value>
+struct RadixKey
+{
+    typedef typename make_unsigned<Key>::type Unsigned;
+
+    static Unsigned toUnsigned(Key key)
+    {
+        Unsigned bits = static_cast<Unsigned>(key);
+        if (is_signed<Key>::value)
+            bits ^= Unsigned(1) << (sizeof(Key) * 8 - 1);
+        return bits;
+    }
+};
+
+template <typename Key>
+struct RadixKey<Key, true>
+{
+    typedef typename conditional<sizeof(Key) == 4, uint32_t, uint64_t>::type Unsigned;
+
+    static Unsigned toUnsigned(Key key)
+    {
+        static_assert(sizeof(Key) == sizeof(Unsigned), "only float and double keys are supported");
+        Unsigned bits;
+        memcpy(&bits, &key, sizeof(Key));
+        const Unsigned signBit = Unsigned(1) << (sizeof(Key) * 8 - 1);
+        return (bits & signBit) ? ~bits : bits ^ signBit;
+    }
+};
+
+/**
+ * @brief Key extractor that uses the element itself as the key
+ */
+struct IdentityKey
+{
+    template <typename Object>
+    const Object& operator()(const Object& object) const
+    {
+        return object;
+    }
+};
+
+/**
+ * @brief Sorts a contiguous range by an arithmetic key with LSD radix sort
+ *
+ * One byte of the key is processed per pass, least significant first. All byte
+ * histograms are computed in a single read of the input, and passes in which every
+ * element has the same byte are skipped, so narrow key ranges cost fewer passes.
+ *
+ * @param begin Contiguous iterator to the first element
+ * @param end Contiguous iterator past the last element
+ * @param keyOf Callable returning the integer or floating-point key of an element
+ *
+ * @note Complexity: O(N * sizeof(Key)) time, O(N) extra space
+ * @note Stable
+ */
+template <typename Iterator, typename KeyExtractor>
+void radixSort(Iterator begin, Iterator end, KeyExtractor keyOf)
+{
+    typedef typename iterator_traits<Iterator>::value_type Object;
+    typedef typename decay<decltype(keyOf(*begin))>::type Key;
+    typedef typename RadixKey<Key>::Unsigned Unsigned;
+    const int BYTES = sizeof(Unsigned);
+
+    size_t n = end - begin;
+    if (n < 2)
+        return;
+
+    Object* source = &*begin;
+    vector<Object> buffer(n);
+    Object* target = buffer.data();
+
+    vector<Unsigned> keys(n), keyBuffer(n);
+    vector<size_t> counts(BYTES * 256, 0);
+    for (size_t i = 0; i < n; i++)
+    {
+        keys[i] = RadixKey<Key>::toUnsigned(keyOf(source[i]));
+        for (int b = 0; b < BYTES; b++)
+            counts[b * 256 + ((keys[i] >> (8 * b)) & 0xFF)]++;
+    }
+
+    Unsigned* sourceKeys = keys.data();
+    Unsigned* targetKeys = keyBuffer.data();
+    bool inBuffer = false;
+    for (int b = 0; b < BYTES; b++)
+    {
+        size_t* count = &counts[b * 256];
+        if (count[(sourceKeys[0] >> (8 * b)) & 0xFF] == n)
+            continue;
+
+        size_t offset[256];
+        size_t sum = 0;
+        for (int d = 0; d < 256; d++)
+        {
+            offset[d] = sum;
+            sum += count[d];
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            size_t position = offset[(sourceKeys[i] >> (8 * b)) & 0xFF]++;
+            targetKeys[position] = sourceKeys[i];
+            target[position] = std::move(source[i]);
+        }
+        swap(source, target);
+        swap(sourceKeys, targetKeys);
+        inBuffer = !inBuffer;
+    }
+
+    if (inBuffer)
+    {
+        Object* out = &*begin;
+        for (size_t i = 0; i < n; i++)
+            out[i] = std::move(source[i]);
+    }
+}
+
+/**
+ * @brief Sorts a contiguous range of integers or floating-point numbers in ascending order
+ */
+template <typename Iterator>
+void radixSort(Iterator begin, Iterator end)
+{
+    radixSort(begin, end, IdentityKey{});
+}
+
+#endif
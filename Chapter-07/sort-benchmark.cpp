@@ -0,0 +1,117 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include "pdqsort.h"
+#include "radix-sort.h"
+#include "parallel-merge-sort.h"
+#include "../Chapter-03/Vector.h"
+#include "../Chapter-01/collection/collection-template.h"
+using namespace std;
+
+/**
+ * @brief Sample record sorted by a floating-point key through key extraction
+ */
+struct Reading
+{
+    double value;
+    int sensor;
+};
+
+/**
+ * @brief Builds N integers following one of the benchmark input patterns
+ * @param pattern One of "random", "sorted", "reversed", "few-unique"
+ * @param n Number of elements
+ * @return The generated input
+ */
+vector<int> makeInput(const string& pattern, size_t n)
+{
+    vector<int> numbers(n);
+    mt19937 generator(2024);
+    for (size_t i = 0; i < n; i++)
+    {
+        if (pattern == "sorted")
+            numbers[i] = i;
+        else if (pattern == "reversed")
+            numbers[i] = n - i;
+        else if (pattern == "few-unique")
+            numbers[i] = generator() % 16;
+        else
+            numbers[i] = generator();
+    }
+    return numbers;
+}
+
+/**
+ * @brief Times sorter on a copy of input and checks the result
+ * @return Elapsed milliseconds, or -1 if the output was not sorted
+ */
+template <typename Sorter>
+double timeSort(const vector<int>& input, Sorter sorter)
+{
+    vector<int> numbers = input;
+    auto start = chrono::high_resolution_clock::now();
+    sorter(numbers);
+    auto stop = chrono::high_resolution_clock::now();
+    if (!is_sorted(numbers.begin(), numbers.end()))
+        return -1;
+    return chrono::duration<double, milli>(stop - start).count();
+}
+
+/**
+ * @brief Benchmarks pdqsort, radix sort and parallel merge sort against std::sort
+ *
+ * Usage: ./sort-benchmark [N] [threads]
+ * Defaults to N = 10^6 and the hardware thread count.
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? stoull(argv[1]) : 1000000;
+    int threads = argc > 2 ? stoi(argv[2]) : max(1u, thread::hardware_concurrency());
+
+    // The same routines work on Vector and Collection storage
+    Vector<int> vec;
+    for (int x : {5, 3, 9, 1, 7})
+        vec.push_back(x);
+    pdqsort(vec.begin(), vec.end());
+    Collection<double> collection(5);
+    for (double x : {2.5, -1.5, 0.0, 10.25, -7.75})
+        collection.insert(x);
+    radixSort(collection.begin(), collection.end());
+    vector<Reading> readings = {{3.5, 1}, {-2.0, 2}, {3.5, 3}, {0.5, 4}};
+    radixSort(readings.begin(), readings.end(), [](const Reading& r) { return r.value; });
+    cout << "Vector: ";
+    for (int x : vec)
+        cout << x << ' ';
+    cout << endl << "Collection: ";
+    for (double x : collection)
+        cout << x << ' ';
+    cout << endl << "Readings: ";
+    for (const Reading& r : readings)
+        cout << r.value << '/' << r.sensor << ' ';
+    cout << endl << endl;
+
+    cout << "N = " << n << ", threads = " << threads << " (times in ms, -1 means wrong output)" << endl;
+    cout << "---------------------------------------------------------------" << endl;
+    cout << "|Input      |std::sort  |pdqsort    |radixSort  |mergeSort   |" << endl;
+    cout << "---------------------------------------------------------------" << endl;
+    for (string pattern : {"random", "sorted", "reversed", "few-unique"})
+    {
+        vector<int> input = makeInput(pattern, n);
+        double stdTime = timeSort(input, [](vector<int>& v) { sort(v.begin(), v.end()); });
+        double pdqTime = timeSort(input, [](vector<int>& v) { pdqsort(v.begin(), v.end()); });
+        double radixTime = timeSort(input, [](vector<int>& v) { radixSort(v.begin(), v.end()); });
+        double mergeTime = timeSort(input, [threads](vector<int>& v)
+        {
+            parallelMergeSort(v.begin(), v.end(), less<int>(), threads);
+        });
+        printf("|%-11s|%-11.1f|%-11.1f|%-11.1f|%-12.1f|\n", pattern.c_str(), stdTime, pdqTime, radixTime, mergeTime);
+    }
+    cout << "---------------------------------------------------------------" << endl;
+    return 0;
+}
@@ -0,0 +1,417 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+using namespace std;
+
+/**
+ * @brief Keeps the compiler from optimizing away a value computed in a benchmark
+ * @param value The value to keep alive
+ */
+template <typename T>
+void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Pins the calling thread to one CPU
+ * @param cpu CPU index; negative values leave the affinity unchanged
+ * @return true if the thread was pinned
+ */
+inline bool pinToCpu(int cpu)
+{
+#ifdef __linux__
+    if (cpu < 0)
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @class PerfCounters
+ * @brief Hardware counters for cycles, cache misses and branch misses
+ *
+ * Uses Linux perf_event_open on the calling thread, user space only. When the
+ * counters cannot be opened (non-Linux, no PMU, or perf_event_paranoid too strict)
+ * available() is false and every reading is zero.
+ */
+class PerfCounters
+{
+public:
+    static const int COUNT = 3; ///< Number of counters
+
+    PerfCounters()
+    {
+        const unsigned long long configs[COUNT] = {
+#ifdef __linux__
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+#endif
+        };
+        for (int i = 0; i < COUNT; i++)
+        {
+            fds[i] = -1;
+            values[i] = 0;
+#ifdef __linux__
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds[i] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters()
+    {
+#ifdef __linux__
+        for (int fd : fds)
+            if (fd >= 0)
+                close(fd);
+#endif
+    }
+
+    /**
+     * @brief Checks whether all counters were opened
+     */
+    bool available() const
+    {
+        for (int fd : fds)
+            if (fd < 0)
+                return false;
+        return true;
+    }
+
+    /**
+     * @brief Resets and starts the counters
+     */
+    void start()
+    {
+#ifdef __linux__
+        for (int fd : fds)
+        {
+            if (fd < 0)
+                continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /**
+     * @brief Stops the counters and reads their values
+     */
+    void stop()
+    {
+        for (int i = 0; i < COUNT; i++)
+        {
+            values[i] = 0;
+#ifdef __linux__
+            if (fds[i] < 0)
+                continue;
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fds[i], &values[i], sizeof(values[i])) != sizeof(values[i]))
+                values[i] = 0;
+#endif
+        }
+    }
+
+    long long cycles() const { return values[0]; }
+    long long cacheMisses() const { return values[1]; }
+    long long branchMisses() const { return values[2]; }
+
+private:
+    int fds[COUNT];
+    long long values[COUNT];
+};
+
+/**
+ * @brief Settings shared by every benchmark of a run
+ */
+struct BenchmarkOptions
+{
+    int warmup = 1;          ///< Untimed runs before measuring
+    int repetitions = 5;     ///< Timed runs per (benchmark, N)
+    int cpu = -1;            ///< CPU to pin to, -1 to leave unpinned
+    bool perfCounters = false; ///< Collect hardware counters
+    string format = "table"; ///< One of "table", "csv", "json"
+};
+
+/**
+ * @brief Summary of the timed repetitions of one benchmark at one N
+ */
+struct BenchmarkResult
+{
+    string name;
+    size_t n;
+    int repetitions;
+    double minMs, medianMs, p90Ms, p99Ms, meanMs;
+    double itemsPerSecond;        ///< Throughput at the median time, 0 if not reported
+    bool hasCounters;
+    long long cycles, cacheMisses, branchMisses; ///< Medians per repetition
+};
+
+/**
+ * @brief Returns the p-th percentile (0 to 100) of sorted samples, interpolating linearly
+ */
+template <typename T>
+double percentile(const vector<T>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+    double rank = p / 100 * (sorted.size() - 1);
+    size_t low = rank;
+    size_t high = min(low + 1, sorted.size() - 1);
+    return sorted[low] + (rank - low) * (sorted[high] - sorted[low]);
+}
+
+/**
+ * @brief Quotes a CSV field, doubling its quotes, when it holds a comma, quote or line break
+ */
+inline string csvField(const string& text)
+{
+    if (text.find_first_of(",\"\r\n") == string::npos)
+        return text;
+    string quoted = "\"";
+    for (char c : text)
+    {
+        if (c == '"')
+            quoted += '"';
+        quoted += c;
+    }
+    return quoted + '"';
+}
+
+/**
+ * @brief Returns text as a JSON string literal, escaping quotes, backslashes and control characters
+ */
+inline string jsonString(const string& text)
+{
+    string quoted = "\"";
+    for (unsigned char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            quoted += '\\';
+            quoted += c;
+        }
+        else if (c < 0x20)
+        {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", c);
+            quoted += escape;
+        }
+        else
+            quoted += c;
+    }
+    return quoted + '"';
+}
+
+/**
+ * @class BenchmarkRunner
+ * @brief Runs benchmarks with warmup and repetitions and reports their statistics
+ */
+class BenchmarkRunner
+{
+public:
+    /**
+     * @brief Constructs a runner and pins the thread if requested
+     * @param options Run settings
+     */
+    explicit BenchmarkRunner(const BenchmarkOptions& options) : options{options}
+    {
+        if (options.cpu >= 0 && !pinToCpu(options.cpu))
+            cerr << "warning: could not pin to CPU " << options.cpu << endl;
+        if (options.perfCounters && !counters.available())
+            cerr << "warning: perf_event counters are not available" << endl;
+    }
+
+    /**
+     * @brief Measures body and records its statistics
+     * @param name Benchmark name
+     * @param n Problem size the body was set up for
+     * @param body Code to time; called warmup + repetitions times
+     * @param items Work items processed by one call of body, for a throughput column (0 for none)
+     */
+    void run(const string& name, size_t n, const function<void()>& body, double items = 0)
+    {
+        for (int i = 0; i < options.warmup; i++)
+            body();
+
+        bool useCounters = options.perfCounters && counters.available();
+        vector<double> times;
+        vector<long long> cycles, cacheMisses, branchMisses;
+        for (int i = 0; i < options.repetitions; i++)
+        {
+            if (useCounters)
+                counters.start();
+            auto start = chrono::steady_clock::now();
+            body();
+            auto stop = chrono::steady_clock::now();
+            if (useCounters)
+            {
+                counters.stop();
+                cycles.push_back(counters.cycles());
+                cacheMisses.push_back(counters.cacheMisses());
+                branchMisses.push_back(counters.branchMisses());
+            }
+            times.push_back(chrono::duration<double, milli>(stop - start).count());
+        }
+
+        sort(times.begin(), times.end());
+        sort(cycles.begin(), cycles.end());
+        sort(cacheMisses.begin(), cacheMisses.end());
+        sort(branchMisses.begin(), branchMisses.end());
+
+        BenchmarkResult result;
+        result.name = name;
+        result.n = n;
+        result.repetitions = times.size();
+        result.minMs = times.empty() ? 0 : times.front();
+        result.medianMs = percentile(times, 50);
+        result.p90Ms = percentile(times, 90);
+        result.p99Ms = percentile(times, 99);
+        double sum = 0;
+        for (double t : times)
+            sum += t;
+        result.meanMs = times.empty() ? 0 : sum / times.size();
+        result.itemsPerSecond = items > 0 && result.medianMs > 0 ? items / (result.medianMs / 1000) : 0;
+        result.hasCounters = useCounters;
+        result.cycles = percentile(cycles, 50);
+        result.cacheMisses = percentile(cacheMisses, 50);
+        result.branchMisses = percentile(branchMisses, 50);
+        results.push_back(result);
+    }
+
+    /**
+     * @brief Gets every result recorded so far
+     */
+    const vector<BenchmarkResult>& getResults() const
+    {
+        return results;
+    }
+
+    /**
+     * @brief Writes all results in the configured format
+     * @param out Destination stream
+     */
+    void report(ostream& out) const
+    {
+        if (options.format == "csv")
+            reportCsv(out);
+        else if (options.format == "json")
+            reportJson(out);
+        else
+            reportTable(out);
+    }
+
+private:
+    BenchmarkOptions options;
+    PerfCounters counters;
+    vector<BenchmarkResult> results;
+
+    void reportTable(ostream& out) const
+    {
+        const string line(options.perfCounters ? 151 : 109, '-');
+        char row[256];
+        out << line << endl;
+        snprintf(row, sizeof(row), "|%-26s|%-10s|%-11s|%-11s|%-11s|%-11s|%-11s|%-12s|",
+                 "Benchmark", "N", "Median (ms)", "Min (ms)", "P90 (ms)", "P99 (ms)", "Mean (ms)", "Items/s");
+        out << row;
+        if (options.perfCounters)
+        {
+            snprintf(row, sizeof(row), "%-13s|%-13s|%-13s|", "Cycles", "Cache misses", "Branch misses");
+            out << row;
+        }
+        out << endl << line << endl;
+        for (const BenchmarkResult& r : results)
+        {
+            snprintf(row, sizeof(row), "|%-26s|%-10zu|%-11.3f|%-11.3f|%-11.3f|%-11.3f|%-11.3f|",
+                     r.name.c_str(), r.n, r.medianMs, r.minMs, r.p90Ms, r.p99Ms, r.meanMs);
+            out << row;
+            if (r.itemsPerSecond > 0)
+                snprintf(row, sizeof(row), "%-12.4g|", r.itemsPerSecond);
+            else
+                snprintf(row, sizeof(row), "%-12s|", "-");
+            out << row;
+            if (options.perfCounters && r.hasCounters)
+            {
+                snprintf(row, sizeof(row), "%-13lld|%-13lld|%-13lld|", r.cycles, r.cacheMisses, r.branchMisses);
+                out << row;
+            }
+            else if (options.perfCounters)
+            {
+                snprintf(row, sizeof(row), "%-13s|%-13s|%-13s|", "-", "-", "-");
+                out << row;
+            }
+            out << endl;
+        }
+        out << line << endl;
+    }
+
+    void reportCsv(ostream& out) const
+    {
+        out << "name,n,repetitions,median_ms,min_ms,p90_ms,p99_ms,mean_ms,items_per_second,cycles,cache_misses,branch_misses" << endl;
+        for (const BenchmarkResult& r : results)
+        {
+            out << csvField(r.name) << ',' << r.n << ',' << r.repetitions << ',' << r.medianMs << ',' << r.minMs << ','
+                << r.p90Ms << ',' << r.p99Ms << ',' << r.meanMs << ',' << r.itemsPerSecond << ',';
+            if (r.hasCounters)
+                out << r.cycles << ',' << r.cacheMisses << ',' << r.branchMisses;
+            else
+                out << ",,";
+            out << endl;
+        }
+    }
+
+    void reportJson(ostream& out) const
+    {
+        out << "[" << endl;
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const BenchmarkResult& r = results[i];
+            out << "  {\"name\": " << jsonString(r.name) << ", \"n\": " << r.n
+                << ", \"repetitions\": " << r.repetitions
+                << ", \"median_ms\": " << r.medianMs << ", \"min_ms\": " << r.minMs
+                << ", \"p90_ms\": " << r.p90Ms << ", \"p99_ms\": " << r.p99Ms
+                << ", \"mean_ms\": " << r.meanMs << ", \"items_per_second\": " << r.itemsPerSecond;
+            if (r.hasCounters)
+                out << ", \"cycles\": " << r.cycles << ", \"cache_misses\": " << r.cacheMisses
+                    << ", \"branch_misses\": " << r.branchMisses;
+            out << "}" << (i + 1 < results.size() ? "," : "") << endl;
+        }
+        out << "]" << endl;
+    }
+};
+
+#endif
@@ -0,0 +1,1069 @@
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <deque>
+#include <list>
+#include <string>
+#include <random>
+#include <climits>
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <fstream>
+#include <filesystem>
+#include <cstdio>
+#include "benchmark.h"
+#include "../Chapter-01/container-stats.h"
+#include "../Chapter-03/Vector.h"
+#include "../Chapter-03/ConcurrentVector.h"
+#include "../Chapter-03/List.h"
+#include "../Chapter-03/RingQueue.h"
+#include "../Chapter-01/Matrix/Matrix.h"
+#include "../Chapter-01/Matrix/max-subrectangle.h"
+#include "../Chapter-01/collection/collection-template.h"
+#include "../Chapter-01/ordered-collection/ordered-collection.h"
+#include "../Chapter-01/maximum-subarray-sum.h"
+#include "../Chapter-01/max-subarray-index/max-subarray-index.h"
+#include "../Chapter-01/permutation.h"
+#include "../Chapter-01/permutations/permutation-range.h"
+#include "../Chapter-01/permutations/permutation-rank.h"
+#include "../Chapter-01/puzzle-word-problem.h"
+#include "../Chapter-01/word-search/word-trie.h"
+#include "../Chapter-01/word-search/grid-file.h"
+#include "../Chapter-01/word-search/parallel-word-search.h"
+#include "../Chapter-01/word-search/word-dictionary.h"
+#include "../Chapter-01/binary-representation.h"
+#include "../Chapter-01/bit-count/popcount.h"
+#include "../Chapter-01/bit-count/bit-vector.h"
+#include "../Chapter-01/rectangles.h"
+#include "../Chapter-01/rectangle-set/rectangle-set.h"
+#include "../Chapter-01/rectangle-set/pareto-frontier.h"
+#include "../Chapter-01/selection-problem.h"
+using namespace std;
+
+// Built for any x86-64; the RectangleSet kernels choose their vector width at run time
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+/**
+ * @brief Stream buffer that discards everything written to it
+ */
+class NullBuffer : public streambuf
+{
+protected:
+    int overflow(int c) override
+    {
+        return c;
+    }
+
+    streamsize xsputn(const char*, streamsize count) override
+    {
+        return count;
+    }
+};
+
+/**
+ * @brief One benchmark: a name, its default sweep and a setup function
+ *
+ * setup(n) builds the input for size n outside the timed region and returns the
+ * code to time. items(n), when set, gives the work items per call for the
+ * throughput column.
+ */
+struct BenchmarkCase
+{
+    string name;
+    vector<size_t> sizes;
+    function<function<void()>(size_t)> setup;
+    function<double(size_t)> items = nullptr;
+};
+
+/**
+ * @brief Computes n! as a double
+ */
+double factorial(size_t n)
+{
+    double result = 1;
+    for (size_t i = 2; i <= n; i++)
+        result *= i;
+    return result;
+}
+
+/**
+ * @brief A per-worker counter on its own cache line, so workers never write to a shared line
+ */
+struct alignas(64) PaddedCounter
+{
+    long long value = 0;
+};
+
+/**
+ * @brief Builds a vector of n random ints in [low, high]
+ */
+vector<int> randomInts(size_t n, int low, int high, unsigned seed = 1)
+{
+    mt19937 generator(seed);
+    uniform_int_distribution<int> value(low, high);
+    vector<int> numbers(n);
+    for (int& x : numbers)
+        x = value(generator);
+    return numbers;
+}
+
+/**
+ * @brief Builds an n x n grid of random lowercase letters; distinct seeds give distinct grids
+ */
+vector<vector<char>> randomGrid(size_t n, unsigned seed = 3)
+{
+    mt19937 generator(seed);
+    vector<vector<char>> grid(n, vector<char>(n));
+    for (vector<char>& row : grid)
+        for (char& c : row)
+            c = 'a' + generator() % 26;
+    return grid;
+}
+
+/**
+ * @brief Builds count random lowercase words of 3 to 6 letters
+ */
+vector<string> randomWords(size_t count)
+{
+    mt19937 generator(5);
+    vector<string> wordList(count);
+    for (string& word : wordList)
+        for (int length = 3 + generator() % 4; length > 0; length--)
+            word.push_back('a' + generator() % 26);
+    return wordList;
+}
+
+/**
+ * @brief Path of a file in the temporary directory, removed when the last copy of the pointer goes away
+ */
+shared_ptr<const string> temporaryFile(const string& name)
+{
+    return shared_ptr<const string>(new string((filesystem::temp_directory_path() / name).string()),
+                                    [](const string* path)
+                                    {
+                                        remove(path->c_str());
+                                        delete path;
+                                    });
+}
+
+/**
+ * @brief Writes an n x n grid of random lowercase letters, one row per line, to a temporary file
+ * @return Path of the file, which is removed once the path is released
+ */
+shared_ptr<const string> writeRandomGridFile(size_t n)
+{
+    shared_ptr<const string> path = temporaryFile("benchmark-grid-" + to_string(n) + ".txt");
+    ofstream out(*path, ios::binary);
+    mt19937 generator(3);
+    string row(n + 1, '\n');
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+            row[j] = 'a' + generator() % 26;
+        out.write(row.data(), row.size());
+    }
+    return path;
+}
+
+/**
+ * @brief Builds a set of n rectangles with sides uniform in [1, 1000), generated in place so 1e8 fits
+ */
+shared_ptr<RectangleSet> randomRectangleSet(size_t n, unsigned seed)
+{
+    mt19937 generator(seed);
+    uniform_real_distribution<double> side(1, 1000);
+    auto rectangles = make_shared<RectangleSet>();
+    rectangles->reserve(n);
+    for (size_t i = 0; i < n; i++)
+        rectangles->add(side(generator), side(generator));
+    return rectangles;
+}
+
+/**
+ * @brief Container counts recorded over all calls of one benchmark at one N
+ */
+struct ContainerStatsRow
+{
+    string name;
+    size_t n;
+    int calls;
+    ContainerStats counts;
+};
+
+/**
+ * @brief Prints the container counts per call of every benchmark that touched an instrumented container
+ *
+ * Only filled in when built with -DCONTAINER_STATS.
+ */
+void reportContainerStats(ostream& out, const vector<ContainerStatsRow>& rows)
+{
+    const string line(109, '-');
+    char row[256];
+    out << "Container stats per call" << endl << line << endl;
+    snprintf(row, sizeof(row), "|%-26s|%-10s|%-11s|%-14s|%-11s|%-11s|%-11s|%-7s|",
+             "Benchmark", "N", "Allocs", "Bytes", "Copies", "Moves", "Shifts", "Growths");
+    out << row << endl << line << endl;
+    for (const ContainerStatsRow& r : rows)
+    {
+        const ContainerStats& c = r.counts;
+        if (c.allocations + c.copies + c.moves + c.shifts == 0)
+            continue;
+        snprintf(row, sizeof(row), "|%-26s|%-10zu|%-11.4g|%-14.4g|%-11.4g|%-11.4g|%-11.4g|%-7.4g|",
+                 r.name.c_str(), r.n, (double)c.allocations / r.calls, (double)c.bytesAllocated / r.calls,
+                 (double)c.copies / r.calls, (double)c.moves / r.calls, (double)c.shifts / r.calls,
+                 (double)c.growths / r.calls);
+        out << row << endl;
+    }
+    out << line << endl;
+}
+
+/**
+ * @brief Lists every benchmark. N is the element count unless noted otherwise.
+ * @param threads Thread count used by the parallel benchmarks
+ */
+vector<BenchmarkCase> makeCases(int threads)
+{
+    vector<BenchmarkCase> cases;
+
+    cases.push_back({"Vector::push_back", {10000, 100000, 1000000}, [](size_t n)
+    {
+        return [n]()
+        {
+            Vector<int> vec;
+            for (size_t i = 0; i < n; i++)
+                vec.push_back(i);
+            doNotOptimize(vec.back());
+        };
+    }});
+
+    // N appends shared by T threads, from 1 to 64 threads whatever the core count
+    for (int t = 1; t <= 64; t *= 2)
+    {
+        cases.push_back({"ConcurrentVector T=" + to_string(t), {100000, 1000000}, [t](size_t n)
+        {
+            return [n, t]()
+            {
+                ConcurrentVector<int> vec;
+                vector<thread> workers;
+                for (int w = 0; w < t; w++)
+                    workers.emplace_back([&vec, n, t, w]()
+                    {
+                        for (size_t i = n * w / t; i < n * (w + 1) / t; i++)
+                            vec.push_back(i);
+                    });
+                for (thread& worker : workers)
+                    worker.join();
+                doNotOptimize(vec.size());
+            };
+        }, [](size_t n) { return (double)n; }});
+        cases.push_back({"mutex Vector T=" + to_string(t), {100000, 1000000}, [t](size_t n)
+        {
+            return [n, t]()
+            {
+                Vector<int> vec;
+                mutex lock;
+                vector<thread> workers;
+                for (int w = 0; w < t; w++)
+                    workers.emplace_back([&vec, &lock, n, t, w]()
+                    {
+                        for (size_t i = n * w / t; i < n * (w + 1) / t; i++)
+                        {
+                            lock_guard<mutex> guard(lock);
+                            vec.push_back(i);
+                        }
+                    });
+                for (thread& worker : workers)
+                    worker.join();
+                doNotOptimize(vec.size());
+            };
+        }, [](size_t n) { return (double)n; }});
+    }
+
+    // Lists whose link order is shuffled against allocation order, as after long use
+    cases.push_back({"List traversal", {100000, 1000000}, [](size_t n)
+    {
+        auto numbers = make_shared<List<int>>();
+        List<int> built(numbers->pool());
+        vector<List<int>::iterator> nodes;
+        for (size_t i = 0; i < n; i++)
+        {
+            built.push_back(i);
+            nodes.push_back(--built.end());
+        }
+        shuffle(nodes.begin(), nodes.end(), mt19937(7));
+        for (List<int>::iterator node : nodes)
+            numbers->splice(numbers->end(), built, node);
+        return [numbers]()
+        {
+            long long sum = 0;
+            for (int x : *numbers)
+                sum += x;
+            doNotOptimize(sum);
+        };
+    }, [](size_t n) { return (double)n; }});
+
+    cases.push_back({"std::list traversal", {100000, 1000000}, [](size_t n)
+    {
+        auto numbers = make_shared<list<int>>();
+        list<int> built;
+        vector<list<int>::iterator> nodes;
+        for (size_t i = 0; i < n; i++)
+            nodes.push_back(built.insert(built.end(), i));
+        shuffle(nodes.begin(), nodes.end(), mt19937(7));
+        for (list<int>::iterator node : nodes)
+            numbers->splice(numbers->end(), built, node);
+        return [numbers]()
+        {
+            long long sum = 0;
+            for (int x : *numbers)
+                sum += x;
+            doNotOptimize(sum);
+        };
+    }, [](size_t n) { return (double)n; }});
+
+    // Built by appending, so links follow allocation order; compare UnrolledList with
+    // the in-order List, not with the shuffled lists above
+    cases.push_back({"List traversal in order", {100000, 1000000}, [](size_t n)
+    {
+        auto numbers = make_shared<List<int>>();
+        for (size_t i = 0; i < n; i++)
+            numbers->push_back(i);
+        return [numbers]()
+        {
+            long long sum = 0;
+            for (int x : *numbers)
+                sum += x;
+            doNotOptimize(sum);
+        };
+    }, [](size_t n) { return (double)n; }});
+
+    cases.push_back({"UnrolledList traversal", {100000, 1000000}, [](size_t n)
+    {
+        auto numbers = make_shared<UnrolledList<int>>();
+        for (size_t i = 0; i < n; i++)
+            numbers->push_back(i);
+        return [numbers]()
+        {
+            long long sum = 0;
+            for (int x : *numbers)
+                sum += x;
+            doNotOptimize(sum);
+        };
+    }, [](size_t n) { return (double)n; }});
+
+    // N single-element splices in shuffled order from one list to another
+    cases.push_back({"List splice", {100000, 1000000}, [](size_t n)
+    {
+        auto from = make_shared<List<int>>();
+        auto to = make_shared<List<int>>(from->pool());
+        auto nodes = make_shared<vector<List<int>::iterator>>();
+        for (size_t i = 0; i < n; i++)
+        {
+            from->push_back(i);
+            nodes->push_back(--from->end());
+        }
+        shuffle(nodes->begin(), nodes->end(), mt19937(7));
+        return [from, to, nodes]()
+        {
+            for (List<int>::iterator node : *nodes)
+                to->splice(to->end(), *from, node);
+            from->swap(*to);
+        };
+    }, [](size_t n) { return (double)n; }});
+
+    cases.push_back({"std::list splice", {100000, 1000000}, [](size_t n)
+    {
+        auto from = make_shared<list<int>>(), to = make_shared<list<int>>();
+        auto nodes = make_shared<vector<list<int>::iterator>>();
+        for (size_t i = 0; i < n; i++)
+            nodes->push_back(from->insert(from->end(), i));
+        shuffle(nodes->begin(), nodes->end(), mt19937(7));
+        return [from, to, nodes]()
+        {
+            for (list<int>::iterator node : *nodes)
+                to->splice(to->end(), *from, node);
+            from->swap(*to);
+        };
+    }, [](size_t n) { return (double)n; }});
+
+    cases.push_back({"List push+pop", {100000, 1000000}, [](size_t n)
+    {
+        return [n]()
+        {
+            List<int> numbers;
+            for (size_t i = 0; i < n; i++)
+                numbers.push_back(i);
+            while (!numbers.empty())
+                numbers.pop_front();
+        };
+    }, [](size_t n) { return (double)n; }});
+
+    cases.push_back({"std::list push+pop", {100000, 1000000}, [](size_t n)
+    {
+        return [n]()
+        {
+            list<int> numbers;
+            for (size_t i = 0; i < n; i++)
+                numbers.push_back(i);
+            while (!numbers.empty())
+                numbers.pop_front();
+        };
+    }, [](size_t n) { return (double)n; }});
+
+    // N items through a 1024-slot queue from P producers to P consumers
+    for (int p : {1, 2})
+    {
+        string pairs = to_string(p) + "P" + to_string(p) + "C";
+        if (p == 1)
+            cases.push_back({"SpscQueue " + pairs, {100000, 1000000}, [](size_t n)
+            {
+                return [n]()
+                {
+                    SpscQueue<int> queue(1024);
+                    thread producer([&queue, n]()
+                    {
+                        for (size_t i = 0; i < n; i++)
+                            queue.enqueue(i);
+                    });
+                    long long sum = 0;
+                    for (size_t i = 0; i < n; i++)
+                        sum += queue.dequeue();
+                    producer.join();
+                    doNotOptimize(sum);
+                };
+            }, [](size_t n) { return (double)n; }});
+        cases.push_back({"MpmcQueue " + pairs, {100000, 1000000}, [p](size_t n)
+        {
+            return [n, p]()
+            {
+                MpmcQueue<int> queue(1024);
+                atomic<long long> sum{0};
+                vector<thread> workers;
+                for (int w = 0; w < p; w++)
+                {
+                    workers.emplace_back([&queue, n, p, w]()
+                    {
+                        for (size_t i = n * w / p; i < n * (w + 1) / p; i++)
+                            queue.enqueue(i);
+                    });
+                    workers.emplace_back([&queue, &sum, n, p, w]()
+                    {
+                        long long local = 0;
+                        for (size_t i = n * w / p; i < n * (w + 1) / p; i++)
+                            local += queue.dequeue();
+                        sum += local;
+                    });
+                }
+                for (thread& worker : workers)
+                    worker.join();
+                doNotOptimize(sum.load());
+            };
+        }, [](size_t n) { return (double)n; }});
+        cases.push_back({"mutex deque " + pairs, {100000, 1000000}, [p](size_t n)
+        {
+            return [n, p]()
+            {
+                deque<int> queue;
+                mutex lock;
+                atomic<long long> sum{0};
+                vector<thread> workers;
+                for (int w = 0; w < p; w++)
+                {
+                    workers.emplace_back([&queue, &lock, n, p, w]()
+                    {
+                        for (size_t i = n * w / p; i < n * (w + 1) / p; i++)
+                        {
+                            lock_guard<mutex> guard(lock);
+                            queue.push_back(i);
+                        }
+                    });
+                    workers.emplace_back([&queue, &lock, &sum, n, p, w]()
+                    {
+                        long long local = 0;
+                        for (size_t i = n * w / p; i < n * (w + 1) / p;)
+                        {
+                            unique_lock<mutex> guard(lock);
+                            if (queue.empty())
+                            {
+                                guard.unlock();
+                                this_thread::yield();
+                                continue;
+                            }
+                            local += queue.front();
+                            queue.pop_front();
+                            i++;
+                        }
+                        sum += local;
+                    });
+                }
+                for (thread& worker : workers)
+                    worker.join();
+                doNotOptimize(sum.load());
+            };
+        }, [](size_t n) { return (double)n; }});
+    }
+
+    // N is the side of a square matrix
+    cases.push_back({"Matrix::resize+fill", {256, 512, 1024}, [](size_t n)
+    {
+        return [n]()
+        {
+            Matrix<int> matrix;
+            matrix.resize(n, n);
+            for (int i = 0; i < matrix.numRows(); i++)
+                for (int j = 0; j < matrix.numCols(); j++)
+                    matrix[i][j] = i ^ j;
+            doNotOptimize(matrix[n - 1][n - 1]);
+        };
+    }});
+
+    // N is the side of a square matrix; --sizes=2048 gives the 2k x 2k heatmap
+    cases.push_back({"maxSubRectangle NxN", {128, 256, 512}, [threads](size_t n)
+    {
+        vector<int> values = randomInts(n * n, -100, 100);
+        Matrix<int> matrix(n, n);
+        for (size_t i = 0; i < n; i++)
+            for (size_t j = 0; j < n; j++)
+                matrix[i][j] = values[i * n + j];
+        return [matrix, threads]()
+        {
+            doNotOptimize(maxSubRectangle(matrix, threads).sum);
+        };
+    }});
+
+    // N is the number of columns of an 8N x N matrix; --sizes=1024 gives 8k x 1k
+    cases.push_back({"maxSubRectangle 8NxN", {64, 128, 256}, [threads](size_t n)
+    {
+        vector<int> values = randomInts(8 * n * n, -100, 100);
+        Matrix<int> matrix(8 * n, n);
+        for (size_t i = 0; i < 8 * n; i++)
+            for (size_t j = 0; j < n; j++)
+                matrix[i][j] = values[i * n + j];
+        return [matrix, threads]()
+        {
+            doNotOptimize(maxSubRectangle(matrix, threads).sum);
+        };
+    }});
+
+    cases.push_back({"Collection::insert+remove", {1000, 4000, 16000}, [](size_t n)
+    {
+        vector<int> values = randomInts(n, 0, INT_MAX);
+        return [values]()
+        {
+            Collection<int> collection(values.size());
+            for (int x : values)
+                collection.insert(x);
+            for (int x : values)
+                collection.remove(x);
+            doNotOptimize(collection.isEmpty());
+        };
+    }});
+
+    cases.push_back({"OrderedCollection::insert", {1000, 4000, 16000}, [](size_t n)
+    {
+        vector<int> values = randomInts(n, 0, INT_MAX);
+        return [values]()
+        {
+            OrderedCollection<int> collection(values.size());
+            for (int x : values)
+                collection.insert(x);
+            doNotOptimize(collection.findMax());
+        };
+    }});
+
+    cases.push_back({"maxSubarraySum", {10000, 100000, 1000000}, [](size_t n)
+    {
+        vector<int> values = randomInts(n, -1000, 1000);
+        return [values]()
+        {
+            doNotOptimize(maxSubarraySum(values));
+        };
+    }});
+
+    cases.push_back({"maxSubarrayKadane", {10000, 100000, 1000000}, [](size_t n)
+    {
+        vector<int> values = randomInts(n, -1000, 1000);
+        return [values]()
+        {
+            doNotOptimize(maxSubarrayKadane(values).sum);
+        };
+    }});
+
+    cases.push_back({"maxSubarrayParallel", {10000, 100000, 1000000}, [threads](size_t n)
+    {
+        vector<int> values = randomInts(n, -1000, 1000);
+        return [values, threads]()
+        {
+            doNotOptimize(maxSubarrayParallel(values, threads).sum);
+        };
+    }});
+
+    // 1000 point updates, each followed by a range query and a trailing-window query
+    cases.push_back({"MaxSubarrayIndex 1k ops", {10000, 100000, 1000000}, [](size_t n)
+    {
+        shared_ptr<MaxSubarrayIndex> index = make_shared<MaxSubarrayIndex>(randomInts(n, -1000, 1000));
+        vector<int> positions = randomInts(1000, 0, n - 1, 6);
+        return [index, positions]()
+        {
+            long long total = 0;
+            for (int position : positions)
+            {
+                index->update(position, -position % 1000);
+                total += index->query(position / 2, position + 1).sum + index->window(1000).sum;
+            }
+            doNotOptimize(total);
+        };
+    }});
+
+    // The same 1000 updates answered by rescanning everything with Kadane
+    cases.push_back({"Kadane rescan 1k ops", {10000, 100000, 1000000}, [](size_t n)
+    {
+        shared_ptr<vector<int>> values = make_shared<vector<int>>(randomInts(n, -1000, 1000));
+        vector<int> positions = randomInts(1000, 0, n - 1, 6);
+        return [values, positions]()
+        {
+            long long total = 0;
+            for (int position : positions)
+            {
+                (*values)[position] = -position % 1000;
+                total += maxSubarrayKadane(*values).sum;
+            }
+            doNotOptimize(total);
+        };
+    }});
+
+    // N is the length of the string being permuted
+    cases.push_back({"permute", {6, 7, 8}, [](size_t n)
+    {
+        string str;
+        for (size_t i = 0; i < n; i++)
+            str.push_back('a' + i % 26);
+        return [str]()
+        {
+            NullBuffer buffer;
+            ostream out(&buffer);
+            permute(str, out);
+        };
+    }, factorial});
+
+    // Lexicographic in-place generator with block output; N is the string length
+    cases.push_back({"Permutations+Writer", {6, 7, 8, 9, 10}, [](size_t n)
+    {
+        string str;
+        for (size_t i = 0; i < n; i++)
+            str.push_back('a' + i % 26);
+        return [str]()
+        {
+            NullBuffer buffer;
+            ostream out(&buffer);
+            BufferedWriter writer(out);
+            for (const string& permutation : permutations(str))
+                writer.writeLine(permutation);
+        };
+    }, factorial});
+
+    // Rank-partitioned enumeration from 1 to 64 threads whatever the core count; --sizes=13 gives 13!
+    for (int t = 1; t <= 64; t *= 2)
+    {
+        cases.push_back({"parallelPermutations T=" + to_string(t), {9, 10, 11}, [t](size_t n)
+        {
+            string str;
+            for (size_t i = 0; i < n; i++)
+                str.push_back('a' + i % 26);
+            return [str, t]()
+            {
+                vector<PaddedCounter> perWorker(t);
+                parallelForEachPermutation(str, t, [&](const string& p, int worker)
+                {
+                    perWorker[worker].value += p.front() < p.back();
+                });
+                doNotOptimize(perWorker[0].value);
+            };
+        }, factorial});
+    }
+
+    // N is the side of a square grid searched for 100 random words
+    cases.push_back({"puzzleWords", {16, 32, 64}, [](size_t n)
+    {
+        vector<vector<char>> grid = randomGrid(n);
+        vector<string> wordList = randomWords(100);
+        return [grid, wordList]()
+        {
+            doNotOptimize(puzzleWords(grid, wordList).size());
+        };
+    }});
+
+    // Same grids; the dictionary has 100 words (as above) or 200k words, and is compiled outside the timing
+    for (size_t dictionarySize : {100, 200000})
+    {
+        string suffix = dictionarySize == 100 ? " 100w" : " 200kw";
+        cases.push_back({"findWordsTrie" + suffix, {16, 64, 256}, [dictionarySize](size_t n)
+        {
+            shared_ptr<vector<char>> cells = make_shared<vector<char>>(flattenGrid(randomGrid(n)));
+            shared_ptr<WordTrie> trie = make_shared<WordTrie>(randomWords(dictionarySize));
+            return [cells, trie, n]()
+            {
+                GridView view = {cells->data(), (int)n, (int)n};
+                doNotOptimize(findWordsTrie(view, *trie).size());
+            };
+        }});
+        cases.push_back({"findWordsAhoCorasick" + suffix, {16, 64, 256}, [dictionarySize](size_t n)
+        {
+            shared_ptr<vector<char>> cells = make_shared<vector<char>>(flattenGrid(randomGrid(n)));
+            shared_ptr<WordTrie> trie = make_shared<WordTrie>(randomWords(dictionarySize));
+            shared_ptr<AhoCorasick> automaton = make_shared<AhoCorasick>(*trie);
+            return [cells, trie, automaton, n]()
+            {
+                GridView view = {cells->data(), (int)n, (int)n};
+                doNotOptimize(findWordsAhoCorasick(view, *automaton).size());
+            };
+        }});
+        cases.push_back({"findWordsDictionary" + suffix, {16, 64, 256}, [dictionarySize](size_t n)
+        {
+            shared_ptr<vector<char>> cells = make_shared<vector<char>>(flattenGrid(randomGrid(n)));
+            shared_ptr<WordDictionary> dictionary = make_shared<WordDictionary>(compileDictionary(randomWords(dictionarySize)));
+            return [cells, dictionary, n]()
+            {
+                GridView view = {cells->data(), (int)n, (int)n};
+                doNotOptimize(findWordsDictionary(view, *dictionary).size());
+            };
+        }});
+    }
+
+    // N is the side of a square grid file (--sizes=20000 for 20k x 20k) searched for 10k words,
+    // from 1 to 64 threads whatever the core count
+    for (int t = 1; t <= 64; t *= 2)
+    {
+        cases.push_back({"findWordsParallel T=" + to_string(t), {1024, 4096}, [t](size_t n)
+        {
+            shared_ptr<GridFile> grid = make_shared<GridFile>(*writeRandomGridFile(n), t);
+            shared_ptr<WordTrie> trie = make_shared<WordTrie>(randomWords(10000));
+            shared_ptr<AhoCorasick> automaton = make_shared<AhoCorasick>(*trie);
+            return [grid, trie, automaton, t]()
+            {
+                doNotOptimize(findWordsParallel(grid->view(), *automaton, t).size());
+            };
+        }, [](size_t n) { return (double)n * n; }});
+    }
+
+    // Memory-maps an N x N grid file and copies it into the flat buffer
+    cases.push_back({"GridFile load", {1024, 4096}, [threads](size_t n)
+    {
+        shared_ptr<const string> path = writeRandomGridFile(n);
+        return [path, threads]()
+        {
+            GridFile grid(*path, threads);
+            doNotOptimize(grid.view().cells[0]);
+        };
+    }, [](size_t n) { return (double)n * n; }});
+
+    // Startup for an N-word dictionary: building the trie and automaton from the word list,
+    // against mapping (and checksumming) a compiled dictionary file
+    cases.push_back({"startup: trie+automaton", {10000, 200000}, [](size_t n)
+    {
+        vector<string> wordList = randomWords(n);
+        return [wordList]()
+        {
+            WordTrie trie(wordList);
+            AhoCorasick automaton(trie);
+            doNotOptimize(automaton.dictionary().nodeCount());
+        };
+    }, [](size_t n) { return (double)n; }});
+    cases.push_back({"startup: mapped dictionary", {10000, 200000}, [](size_t n)
+    {
+        shared_ptr<const string> path = temporaryFile("benchmark-words-" + to_string(n) + ".dict");
+        writeDictionary(randomWords(n), *path);
+        return [path]()
+        {
+            WordDictionary dictionary(*path);
+            doNotOptimize(dictionary.size());
+        };
+    }, [](size_t n) { return (double)n; }});
+
+    // N small 16x16 puzzles against 10k words: rebuilding the lookup structures per
+    // puzzle, as puzzleWords callers do, against one mapped dictionary for the batch
+    cases.push_back({"puzzles: rebuild each", {10, 100}, [](size_t n)
+    {
+        shared_ptr<vector<vector<char>>> grids = make_shared<vector<vector<char>>>();
+        for (size_t i = 0; i < n; i++)
+            grids->push_back(flattenGrid(randomGrid(16, 100 + i)));
+        shared_ptr<vector<string>> wordList = make_shared<vector<string>>(randomWords(10000));
+        return [grids, wordList]()
+        {
+            size_t total = 0;
+            for (const vector<char>& cells : *grids)
+            {
+                WordTrie trie(*wordList);
+                AhoCorasick automaton(trie);
+                total += findWordsAhoCorasick({cells.data(), 16, 16}, automaton).size();
+            }
+            doNotOptimize(total);
+        };
+    }, [](size_t n) { return (double)n; }});
+    cases.push_back({"puzzles: findWordsBatch", {10, 100}, [threads](size_t n)
+    {
+        shared_ptr<vector<vector<char>>> grids = make_shared<vector<vector<char>>>();
+        for (size_t i = 0; i < n; i++)
+            grids->push_back(flattenGrid(randomGrid(16, 100 + i)));
+        shared_ptr<const string> path = temporaryFile("benchmark-words-10000.dict");
+        writeDictionary(randomWords(10000), *path);
+        return [grids, path, threads]()
+        {
+            WordDictionary dictionary(*path);
+            vector<GridView> views;
+            for (const vector<char>& cells : *grids)
+                views.push_back({cells.data(), 16, 16});
+            doNotOptimize(findWordsBatch(views, dictionary, threads).size());
+        };
+    }, [](size_t n) { return (double)n; }});
+
+    cases.push_back({"binaryOnes", {100000, 1000000}, [](size_t n)
+    {
+        vector<int> values = randomInts(n, 1, INT_MAX);
+        return [values]()
+        {
+            long long total = 0;
+            for (int x : values)
+                total += binaryOnes(x);
+            doNotOptimize(total);
+        };
+    }});
+
+    // N is the bitmap size in bytes (L1, L2 and DRAM resident), so Items/s reads as bytes per second
+    for (PopcountKernel kernel : {PopcountKernel::Portable, PopcountKernel::Scalar, PopcountKernel::AVX2, PopcountKernel::AVX512})
+    {
+        if (!kernelSupported(kernel))
+            continue;
+        cases.push_back({"popcount " + kernelName(kernel), {1 << 15, 1 << 20, 1 << 28}, [kernel](size_t n)
+        {
+            shared_ptr<vector<uint64_t>> bitmap = make_shared<vector<uint64_t>>(n / sizeof(uint64_t));
+            mt19937_64 generator(9);
+            for (uint64_t& word : *bitmap)
+                word = generator();
+            return [bitmap, kernel]()
+            {
+                doNotOptimize(popcount(bitmap->data(), bitmap->size(), kernel));
+            };
+        }, [](size_t n) { return (double)n; }});
+        cases.push_back({"popcountAnd " + kernelName(kernel), {1 << 15, 1 << 20, 1 << 28}, [kernel](size_t n)
+        {
+            shared_ptr<vector<uint64_t>> a = make_shared<vector<uint64_t>>(n / 2 / sizeof(uint64_t));
+            shared_ptr<vector<uint64_t>> b = make_shared<vector<uint64_t>>(a->size());
+            mt19937_64 generator(9);
+            for (size_t i = 0; i < a->size(); i++)
+            {
+                (*a)[i] = generator();
+                (*b)[i] = generator();
+            }
+            return [a, b, kernel]()
+            {
+                doNotOptimize(popcountAnd(a->data(), b->data(), a->size(), kernel));
+            };
+        }, [](size_t n) { return (double)n; }});
+    }
+
+    // N is the bit vector length (--sizes=1000000000 for 1G bits), half the bits set; 1M random queries per call
+    for (bool select : {false, true})
+    {
+        cases.push_back({select ? "BitVector::select1" : "BitVector::rank1", {1 << 20, 1 << 27}, [select](size_t n)
+        {
+            shared_ptr<BitVector> bits = make_shared<BitVector>(n);
+            mt19937_64 generator(10);
+            for (size_t i = 0; i < n; i++)
+                if (generator() % 2)
+                    bits->set(i);
+            bits->buildIndex();
+            shared_ptr<vector<uint64_t>> queries = make_shared<vector<uint64_t>>(1 << 20);
+            for (uint64_t& query : *queries)
+                query = generator() % (select ? bits->count() : n + 1);
+            return [bits, queries, select]()
+            {
+                BitVectorView view = bits->view();
+                uint64_t total = 0;
+                for (uint64_t query : *queries)
+                    total += select ? view.select1(query) : view.rank1(query);
+                doNotOptimize(total);
+            };
+        }, [](size_t) { return (double)(1 << 20); }});
+    }
+
+    cases.push_back({"findMax(Area+Perimeter)", {100000, 1000000}, [](size_t n)
+    {
+        vector<int> lengths = randomInts(n, 1, 1000, 4), widths = randomInts(n, 1, 1000, 5);
+        vector<Rectangle> rectangles;
+        rectangles.reserve(n);
+        for (size_t i = 0; i < n; i++)
+            rectangles.emplace_back(lengths[i], widths[i]);
+        return [rectangles]()
+        {
+            doNotOptimize(findMax(rectangles, AreaComparator{}).getLength());
+            doNotOptimize(findMax(rectangles, PerimeterComparator{}).getLength());
+        };
+    }});
+
+    // Same queries on the structure-of-arrays layout, from 1 to 64 threads whatever the core count;
+    // sweep to 1e8 with --sizes
+    for (int t = 1; t <= 64; t *= 2)
+    {
+        cases.push_back({"RectangleSet argMax T=" + to_string(t), {100000, 1000000}, [t](size_t n)
+        {
+            vector<int> lengths = randomInts(n, 1, 1000, 4), widths = randomInts(n, 1, 1000, 5);
+            auto rectangles = make_shared<RectangleSet>();
+            rectangles->reserve(n);
+            for (size_t i = 0; i < n; i++)
+                rectangles->add(lengths[i], widths[i]);
+            return [rectangles, t]()
+            {
+                doNotOptimize(rectangles->argMax(AreaComparator{}, t));
+                doNotOptimize(rectangles->argMax(PerimeterComparator{}, t));
+            };
+        }});
+    }
+
+    cases.push_back({"RectangleSet topK(100)", {100000, 1000000}, [threads](size_t n)
+    {
+        vector<int> lengths = randomInts(n, 1, 1000, 4), widths = randomInts(n, 1, 1000, 5);
+        auto rectangles = make_shared<RectangleSet>();
+        rectangles->reserve(n);
+        for (size_t i = 0; i < n; i++)
+            rectangles->add(lengths[i], widths[i]);
+        return [rectangles, threads]()
+        {
+            doNotOptimize(rectangles->topK(100, AreaComparator{}, threads).front());
+        };
+    }});
+
+    // Skylines on (length, width) and (area, perimeter), from 1 to 64 threads whatever the core count;
+    // --sizes=100000000 for the 1e8 run (about 2 GB)
+    for (int t = 1; t <= 64; t *= 2)
+    {
+        cases.push_back({"paretoFrontier L/W T=" + to_string(t), {1000000, 10000000}, [t](size_t n)
+        {
+            shared_ptr<RectangleSet> rectangles = randomRectangleSet(n, 6);
+            return [rectangles, t]()
+            {
+                doNotOptimize(paretoFrontierBySides(*rectangles, t).size());
+            };
+        }});
+        cases.push_back({"paretoFrontier A/P T=" + to_string(t), {1000000, 10000000}, [t](size_t n)
+        {
+            shared_ptr<RectangleSet> rectangles = randomRectangleSet(n, 6);
+            return [rectangles, t]()
+            {
+                doNotOptimize(paretoFrontierByAreaPerimeter(*rectangles, t).size());
+            };
+        }});
+    }
+
+    cases.push_back({"ParetoFrontier::insert", {1000000, 10000000}, [](size_t n)
+    {
+        shared_ptr<RectangleSet> rectangles = randomRectangleSet(n, 6);
+        return [rectangles]()
+        {
+            ParetoFrontier frontier;
+            for (size_t i = 0; i < rectangles->size(); i++)
+                frontier.insert(rectangles->lengthData()[i], rectangles->widthData()[i], i);
+            doNotOptimize(frontier.size());
+        };
+    }});
+
+    // Reproduces the running-time table kept in selection-problem.cpp
+    cases.push_back({"selectionSort", {1000, 2000, 5000, 10000}, [](size_t n)
+    {
+        vector<int> numbers(n);
+        for (size_t i = 0; i < n; i++)
+            numbers[i] = i + 1;
+        return [numbers]()
+        {
+            vector<int> copy = numbers;
+            selectionSort(copy);
+            doNotOptimize(copy[copy.size() / 2]);
+        };
+    }});
+
+    return cases;
+}
+
+/**
+ * @brief Parses a comma-separated list of sizes
+ */
+vector<size_t> parseSizes(const string& list)
+{
+    vector<size_t> sizes;
+    stringstream stream(list);
+    string item;
+    while (getline(stream, item, ','))
+        if (!item.empty())
+            sizes.push_back(stoull(item));
+    return sizes;
+}
+
+/**
+ * @brief Runs the benchmark suite
+ *
+ * Usage: ./benchmark [--filter=SUBSTRING] [--sizes=N1,N2,...] [--warmup=W] [--reps=R]
+ *                    [--cpu=C] [--perf] [--format=table|csv|json] [--threads=T]
+ *
+ * --sizes replaces the default sweep of every selected benchmark. --threads sets the
+ * thread count of the parallel benchmarks (default: hardware thread count).
+ * Built with -DCONTAINER_STATS, a second table gives the allocations, copies,
+ * moves, shifts and growths per call of the instrumented containers; with csv or
+ * json output it goes to stderr so stdout stays machine-readable.
+ *
+ * @return Exit status
+ */
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options;
+    string filter;
+    vector<size_t> sizes;
+    int threads = max(1u, thread::hardware_concurrency());
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        string value = arg.substr(arg.find('=') + 1);
+        if (arg.rfind("--filter=", 0) == 0)
+            filter = value;
+        else if (arg.rfind("--sizes=", 0) == 0)
+            sizes = parseSizes(value);
+        else if (arg.rfind("--warmup=", 0) == 0)
+            options.warmup = stoi(value);
+        else if (arg.rfind("--reps=", 0) == 0)
+            options.repetitions = stoi(value);
+        else if (arg.rfind("--cpu=", 0) == 0)
+            options.cpu = stoi(value);
+        else if (arg == "--perf")
+            options.perfCounters = true;
+        else if (arg.rfind("--format=", 0) == 0)
+            options.format = value;
+        else if (arg.rfind("--threads=", 0) == 0)
+            threads = stoi(value);
+        else
+        {
+            cerr << "unknown option: " << arg << endl;
+            return 1;
+        }
+    }
+
+    BenchmarkRunner runner(options);
+    vector<ContainerStatsRow> containerStats;
+    for (const BenchmarkCase& benchmark : makeCases(threads))
+    {
+        if (benchmark.name.find(filter) == string::npos)
+            continue;
+        for (size_t n : sizes.empty() ? benchmark.sizes : sizes)
+        {
+            function<void()> body = benchmark.setup(n);
+            ContainerStats before = globalContainerStats();
+            runner.run(benchmark.name, n, body, benchmark.items ? benchmark.items(n) : 0);
+            ContainerStats counts = globalContainerStats();
+            counts -= before;
+            containerStats.push_back({benchmark.name, n, options.warmup + options.repetitions, counts});
+        }
+    }
+    runner.report(cout);
+    if (CONTAINER_STATS_ENABLED)
+        reportContainerStats(options.format == "table" ? cout : cerr, containerStats);
+    return 0;
+}